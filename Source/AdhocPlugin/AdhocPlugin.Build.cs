@@ -64,5 +64,11 @@ public class AdhocPlugin : ModuleRules
                 "GameplayTags"
             }
         );
+
+        // metrics are served over HTTP by servers
+        if (Target.bWithServerCode)
+        {
+            PrivateDependencyModuleNames.Add("HTTPServer");
+        }
     }
 }
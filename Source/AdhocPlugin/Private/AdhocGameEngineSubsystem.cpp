@@ -23,6 +23,7 @@
 #include "AIController.h"
 #include "EngineUtils.h"
 #include "AI/AdhocAIControllerComponent.h"
+#include "Diagnostics/AdhocProfiler.h"
 #include "Game/AdhocGameModeComponent.h"
 #include "Game/AdhocGameStateComponent.h"
 #include "GameFramework/Controller.h"
@@ -31,6 +32,7 @@
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/PlayerState.h"
 #include "GameFramework/SpectatorPawn.h"
+#include "Async/ParallelFor.h"
 #include "Objective/AdhocObjectiveComponent.h"
 #include "Pawn/AdhocPawnComponent.h"
 #include "Player/AdhocPlayerControllerComponent.h"
@@ -44,6 +46,8 @@ void UAdhocEngineSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
     UE_LOG(LogAdhocGameEngineSubsystem, Verbose, TEXT("Initialize"));
 
+    FParse::Bool(FCommandLine::Get(), TEXT("ParallelWorldActorInitialization="), bParallelWorldActorInitialization);
+
     FWorldDelegates::OnPostWorldCreation.AddUObject(this, &UAdhocEngineSubsystem::OnPostWorldCreation);
     FWorldDelegates::OnPreWorldInitialization.AddUObject(this, &UAdhocEngineSubsystem::OnPreWorldInitialization);
     FWorldDelegates::OnPostWorldInitialization.AddUObject(this, &UAdhocEngineSubsystem::OnPostWorldInitialization);
@@ -74,13 +78,90 @@ void UAdhocEngineSubsystem::OnPreWorldInitialization(UWorld* World, const UWorld
 // ReSharper disable once CppParameterMayBeConstPtrOrRef
 void UAdhocEngineSubsystem::OnPostWorldInitialization(UWorld* World, UWorld::InitializationValues InitializationValues) const
 {
+    ADHOC_SCOPE(OnPostWorldInitialization);
+
     UE_LOG(LogAdhocGameEngineSubsystem, Verbose, TEXT("OnPostWorldInitialization: World=%s"), *World->GetName());
 
+    const double StartTime = FPlatformTime::Seconds();
+
     // for any existing actors, run the initialization we would have done
+    TArray<AActor*> Actors;
     for (TActorIterator<AActor> ActorIter(World); ActorIter; ++ActorIter)
     {
-        OnActorPreSpawnInitialization(*ActorIter);
+        Actors.Add(*ActorIter);
+    }
+
+    const double GatheredTime = FPlatformTime::Seconds();
+    int32 NumNewClasses = 0;
+    int32 NumComponents = 0;
+
+    if (!bParallelWorldActorInitialization)
+    {
+        const int32 NumClassesBefore = ActorClassComponentKinds.Num();
+        for (AActor* Actor : Actors)
+        {
+            if (UClass* ComponentClass = GetMissingComponentClass(Actor, ApplyInstanceTags(Actor, GetActorClassComponentKind(Actor->GetClass()))))
+            {
+                AddComponent(Actor, ComponentClass);
+                NumComponents++;
+            }
+        }
+        NumNewClasses = ActorClassComponentKinds.Num() - NumClassesBefore;
+    }
+    else
+    {
+        // classify any classes we have not seen before (in parallel) so the per actor pass below only reads the cache
+        TArray<UClass*> NewClasses;
+        {
+            TSet<UClass*> SeenClasses;
+            for (const AActor* Actor : Actors)
+            {
+                UClass* ActorClass = Actor->GetClass();
+                if (!ActorClassComponentKinds.Contains(ActorClass) && !SeenClasses.Contains(ActorClass))
+                {
+                    SeenClasses.Add(ActorClass);
+                    NewClasses.Add(ActorClass);
+                }
+            }
+        }
+        TArray<EAdhocActorComponentKind> NewClassKinds;
+        NewClassKinds.SetNumUninitialized(NewClasses.Num());
+        ParallelFor(NewClasses.Num(), [&NewClasses, &NewClassKinds](const int32 Index)
+        {
+            NewClassKinds[Index] = ClassifyActorClass(NewClasses[Index]);
+        });
+        for (int32 Index = 0; Index < NewClasses.Num(); Index++)
+        {
+            ActorClassComponentKinds.Add(NewClasses[Index], NewClassKinds[Index]);
+        }
+        NumNewClasses = NewClasses.Num();
+
+        // work out (read only) which component each actor is missing
+        TArray<UClass*> MissingComponentClasses;
+        MissingComponentClasses.SetNumZeroed(Actors.Num());
+        ParallelFor(Actors.Num(), [this, &Actors, &MissingComponentClasses](const int32 Index)
+        {
+            const AActor* Actor = Actors[Index];
+            const EAdhocActorComponentKind Kind = ApplyInstanceTags(Actor, ActorClassComponentKinds.FindChecked(Actor->GetClass()));
+            MissingComponentClasses[Index] = GetMissingComponentClass(Actor, Kind);
+        });
+
+        // object creation must stay on the game thread
+        for (int32 Index = 0; Index < Actors.Num(); Index++)
+        {
+            if (MissingComponentClasses[Index])
+            {
+                AddComponent(Actors[Index], MissingComponentClasses[Index]);
+                NumComponents++;
+            }
+        }
     }
+
+    const double EndTime = FPlatformTime::Seconds();
+
+    UE_LOG(LogAdhocGameEngineSubsystem, Log, TEXT("OnPostWorldInitialization: World=%s Parallel=%d Actors=%d NewClasses=%d Components=%d GatherMs=%.2f InitializeMs=%.2f TotalMs=%.2f"),
+        *World->GetName(), bParallelWorldActorInitialization, Actors.Num(), NumNewClasses, NumComponents,
+        (GatheredTime - StartTime) * 1000, (EndTime - GatheredTime) * 1000, (EndTime - StartTime) * 1000);
 }
 
 void UAdhocEngineSubsystem::OnWorldInitializedActors(const UWorld::FActorsInitializedParams& ActorsInitializedParams) const
@@ -95,99 +176,145 @@ void UAdhocEngineSubsystem::OnWorldBeginPlay(UWorld* World) const
 }
 
 // ReSharper disable once CppParameterMayBeConstPtrOrRef
-// ReSharper disable once CppMemberFunctionMayBeStatic
 void UAdhocEngineSubsystem::OnActorPreSpawnInitialization(AActor* Actor) const
 {
     // UE_LOG(LogAdhocGameEngineSubsystem, VeryVerbose, TEXT("OnActorPreSpawnInitialization: Actor=%s"), *Actor->GetName());
 
-    if (Actor->IsA(APawn::StaticClass())
-        && !Actor->IsA(ASpectatorPawn::StaticClass()))
+    // tags on a newly spawned actor are still those of its class defaults at this point so the class decision covers them
+    InitializeActor(Actor, false);
+}
+
+EAdhocActorComponentKind UAdhocEngineSubsystem::GetActorClassComponentKind(const UClass* ActorClass) const
+{
+    if (const EAdhocActorComponentKind* Kind = ActorClassComponentKinds.Find(ActorClass))
     {
-        UE_LOG(LogAdhocGameEngineSubsystem, VeryVerbose, TEXT("OnActorPreSpawnInitialization: Pawn=%s"), *Actor->GetName());
+        return *Kind;
+    }
 
-        if (Actor->HasAuthority() && !Actor->GetComponentByClass(UAdhocPawnComponent::StaticClass()))
-        {
-            UAdhocPawnComponent* AdhocPawnComponent = NewObject<UAdhocPawnComponent>(Actor, UAdhocPawnComponent::StaticClass(), UAdhocPawnComponent::StaticClass()->GetFName());
+    const EAdhocActorComponentKind Kind = ClassifyActorClass(ActorClass);
+    ActorClassComponentKinds.Add(ActorClass, Kind);
+    return Kind;
+}
 
-            // AdhocPawnComponent->RegisterComponent();
-        }
+EAdhocActorComponentKind UAdhocEngineSubsystem::ClassifyActorClass(const UClass* ActorClass)
+{
+    if (ActorClass->IsChildOf(APawn::StaticClass())
+        && !ActorClass->IsChildOf(ASpectatorPawn::StaticClass()))
+    {
+        return EAdhocActorComponentKind::Pawn;
     }
-    else if (Actor->IsA(APlayerController::StaticClass()))
+    if (ActorClass->IsChildOf(APlayerController::StaticClass()))
     {
-        UE_LOG(LogAdhocGameEngineSubsystem, Verbose, TEXT("OnActorPreSpawnInitialization: PlayerController=%s"), *Actor->GetName());
-
-        if (Actor->HasAuthority() && !Actor->GetComponentByClass(UAdhocPlayerControllerComponent::StaticClass()))
-        {
-            UAdhocPlayerControllerComponent* AdhocPlayerControllerComponent = NewObject<UAdhocPlayerControllerComponent>(Actor, UAdhocPlayerControllerComponent::StaticClass(), UAdhocPlayerControllerComponent::StaticClass()->GetFName());
-
-            // AdhocPlayerControllerComponent->RegisterComponent();
-        }
+        return EAdhocActorComponentKind::PlayerController;
     }
-    else if (Actor->IsA(AAIController::StaticClass()))
+    if (ActorClass->IsChildOf(AAIController::StaticClass()))
     {
-        UE_LOG(LogAdhocGameEngineSubsystem, Verbose, TEXT("OnActorPreSpawnInitialization: BotController=%s"), *Actor->GetName());
-
-        if (Actor->HasAuthority() && !Actor->GetComponentByClass(UAdhocAIControllerComponent::StaticClass()))
-        {
-            UAdhocAIControllerComponent* AdhocBotControllerComponent = NewObject<UAdhocAIControllerComponent>(Actor, UAdhocAIControllerComponent::StaticClass(), UAdhocAIControllerComponent::StaticClass()->GetFName());
-
-            // AdhocBotControllerComponent->RegisterComponent();
-        }
+        return EAdhocActorComponentKind::AIController;
     }
-    else if (Actor->IsA(APlayerState::StaticClass()))
+    if (ActorClass->IsChildOf(APlayerState::StaticClass()))
     {
-        UE_LOG(LogAdhocGameEngineSubsystem, Verbose, TEXT("OnActorPreSpawnInitialization: PlayerState=%s"), *Actor->GetName());
-
-        if (Actor->HasAuthority() && !Actor->GetComponentByClass(UAdhocPlayerStateComponent::StaticClass()))
-        {
-            UAdhocPlayerStateComponent* AdhocPlayerStateComponent = NewObject<UAdhocPlayerStateComponent>(Actor, UAdhocPlayerStateComponent::StaticClass(), UAdhocPlayerStateComponent::StaticClass()->GetFName());
-
-            // AdhocPlayerStateComponent->RegisterComponent();
-        }
+        return EAdhocActorComponentKind::PlayerState;
     }
-    else if (Actor->IsA(AGameStateBase::StaticClass()))
+    if (ActorClass->IsChildOf(AGameStateBase::StaticClass()))
     {
-        UE_LOG(LogAdhocGameEngineSubsystem, Verbose, TEXT("OnActorPreSpawnInitialization: GameState=%s"), *Actor->GetName());
-
-        if (Actor->HasAuthority() && !Actor->GetComponentByClass(UAdhocGameStateComponent::StaticClass()))
-        {
-            UAdhocGameStateComponent* AdhocGameStateComponent = NewObject<UAdhocGameStateComponent>(Actor, UAdhocGameStateComponent::StaticClass(), UAdhocGameStateComponent::StaticClass()->GetFName());
+        return EAdhocActorComponentKind::GameState;
+    }
 
-            // AdhocGameStateComponent->RegisterComponent();
-        }
+    const AActor* DefaultActor = ActorClass->GetDefaultObject<AActor>();
+    if (DefaultActor->ActorHasTag(TEXT("Adhoc_Area")))
+    {
+        return EAdhocActorComponentKind::Area;
     }
-    else if (Actor->ActorHasTag(TEXT("Adhoc_Area")))
+    if (DefaultActor->ActorHasTag(TEXT("Adhoc_Objective")))
     {
-        UE_LOG(LogAdhocGameEngineSubsystem, Verbose, TEXT("OnActorPreSpawnInitialization: Area=%s"), *Actor->GetName());
+        return EAdhocActorComponentKind::Objective;
+    }
 
-        if (Actor->HasAuthority() && !Actor->GetComponentByClass(UAdhocAreaComponent::StaticClass()))
-        {
-            UAdhocAreaComponent* AdhocAreaComponent = NewObject<UAdhocAreaComponent>(Actor, UAdhocAreaComponent::StaticClass(), UAdhocAreaComponent::StaticClass()->GetFName());
+    if (ActorClass->IsChildOf(AGameModeBase::StaticClass()))
+    {
+        return EAdhocActorComponentKind::GameMode;
+    }
+    return EAdhocActorComponentKind::None;
+}
 
-            // AdhocAreaComponent->RegisterComponent();
+EAdhocActorComponentKind UAdhocEngineSubsystem::ApplyInstanceTags(const AActor* Actor, const EAdhocActorComponentKind ClassKind)
+{
+    // level placed actors may have been tagged individually (tags are checked before the game mode, as the class defaults are)
+    if ((ClassKind == EAdhocActorComponentKind::None || ClassKind == EAdhocActorComponentKind::GameMode) && Actor->Tags.Num() > 0)
+    {
+        if (Actor->ActorHasTag(TEXT("Adhoc_Area")))
+        {
+            return EAdhocActorComponentKind::Area;
+        }
+        if (Actor->ActorHasTag(TEXT("Adhoc_Objective")))
+        {
+            return EAdhocActorComponentKind::Objective;
         }
     }
-    else if (Actor->ActorHasTag(TEXT("Adhoc_Objective")))
+    return ClassKind;
+}
+
+UClass* UAdhocEngineSubsystem::GetComponentClass(const EAdhocActorComponentKind Kind)
+{
+    switch (Kind)
     {
-        UE_LOG(LogAdhocGameEngineSubsystem, Verbose, TEXT("OnActorPreSpawnInitialization: Objective=%s"), *Actor->GetName());
+    case EAdhocActorComponentKind::Pawn:
+        return UAdhocPawnComponent::StaticClass();
+    case EAdhocActorComponentKind::PlayerController:
+        return UAdhocPlayerControllerComponent::StaticClass();
+    case EAdhocActorComponentKind::AIController:
+        return UAdhocAIControllerComponent::StaticClass();
+    case EAdhocActorComponentKind::PlayerState:
+        return UAdhocPlayerStateComponent::StaticClass();
+    case EAdhocActorComponentKind::GameState:
+        return UAdhocGameStateComponent::StaticClass();
+    case EAdhocActorComponentKind::Area:
+        return UAdhocAreaComponent::StaticClass();
+    case EAdhocActorComponentKind::Objective:
+        return UAdhocObjectiveComponent::StaticClass();
+    case EAdhocActorComponentKind::GameMode:
+        return UAdhocGameModeComponent::StaticClass();
+    default:
+        return nullptr;
+    }
+}
 
-        if (Actor->HasAuthority() && !Actor->GetComponentByClass(UAdhocObjectiveComponent::StaticClass()))
-        {
-            UAdhocObjectiveComponent* AdhocObjectiveComponent = NewObject<UAdhocObjectiveComponent>(Actor, UAdhocObjectiveComponent::StaticClass(), UAdhocObjectiveComponent::StaticClass()->GetFName());
+UClass* UAdhocEngineSubsystem::GetMissingComponentClass(const AActor* Actor, const EAdhocActorComponentKind Kind)
+{
+    UClass* ComponentClass = GetComponentClass(Kind);
+    if (!ComponentClass || !Actor->HasAuthority() || Actor->GetComponentByClass(ComponentClass))
+    {
+        return nullptr;
+    }
+    return ComponentClass;
+}
 
-            // AdhocObjectiveComponent->RegisterComponent();
-        }
+void UAdhocEngineSubsystem::AddComponent(AActor* Actor, UClass* ComponentClass)
+{
+    if (ComponentClass == UAdhocPawnComponent::StaticClass())
+    {
+        UE_LOG(LogAdhocGameEngineSubsystem, VeryVerbose, TEXT("Adding %s to %s"), *ComponentClass->GetName(), *Actor->GetName());
     }
-    else if (Actor->IsA(AGameModeBase::StaticClass()))
+    else
     {
-        UE_LOG(LogAdhocGameEngineSubsystem, Verbose, TEXT("OnActorPreSpawnInitialization: GameMode=%s"), *Actor->GetName());
+        UE_LOG(LogAdhocGameEngineSubsystem, Verbose, TEXT("Adding %s to %s"), *ComponentClass->GetName(), *Actor->GetName());
+    }
 
-        if (Actor->HasAuthority() && !Actor->GetComponentByClass(UAdhocGameModeComponent::StaticClass()))
-        {
-            UAdhocGameModeComponent* AdhocGameModeComponent = NewObject<UAdhocGameModeComponent>(Actor, UAdhocGameModeComponent::StaticClass(), UAdhocGameModeComponent::StaticClass()->GetFName());
+    NewObject<UActorComponent>(Actor, ComponentClass, ComponentClass->GetFName());
+}
 
-            // AdhocGameModeComponent->RegisterComponent();
-        }
+// ReSharper disable once CppParameterMayBeConstPtrOrRef
+void UAdhocEngineSubsystem::InitializeActor(AActor* Actor, const bool bCheckInstanceTags) const
+{
+    EAdhocActorComponentKind Kind = GetActorClassComponentKind(Actor->GetClass());
+    if (bCheckInstanceTags)
+    {
+        Kind = ApplyInstanceTags(Actor, Kind);
+    }
+
+    if (UClass* ComponentClass = GetMissingComponentClass(Actor, Kind))
+    {
+        AddComponent(Actor, ComponentClass);
     }
 }
 
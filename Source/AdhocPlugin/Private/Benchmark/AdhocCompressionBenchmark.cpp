@@ -0,0 +1,138 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Manager/AdhocManagerClient.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+#if !UE_BUILD_SHIPPING
+
+DEFINE_LOG_CATEGORY_STATIC(LogAdhocCompressionBenchmark, Log, All);
+
+namespace AdhocCompressionBenchmark
+{
+    /** Build a synthetic objectives submission in the same shape as UAdhocGameModeComponent::SubmitObjectives. */
+    static FString CreateObjectivesJson(const int32 NumObjectives)
+    {
+        FRandomStream Random(NumObjectives);
+
+        FString JsonString;
+        const auto& Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+
+        Writer->WriteArrayStart();
+        for (int32 ObjectiveIndex = 0; ObjectiveIndex < NumObjectives; ObjectiveIndex++)
+        {
+            Writer->WriteObjectStart();
+            Writer->WriteValue(TEXT("regionId"), 1);
+            Writer->WriteValue(TEXT("index"), ObjectiveIndex);
+            Writer->WriteValue(TEXT("name"), FString::Printf(TEXT("Objective %d"), ObjectiveIndex));
+            Writer->WriteValue(TEXT("x"), static_cast<double>(Random.FRandRange(-500000, 500000)));
+            Writer->WriteValue(TEXT("y"), static_cast<double>(Random.FRandRange(-500000, 500000)));
+            Writer->WriteValue(TEXT("z"), static_cast<double>(Random.FRandRange(0, 20000)));
+            Writer->WriteValue(TEXT("sizeX"), 1.0);
+            Writer->WriteValue(TEXT("sizeY"), 1.0);
+            Writer->WriteValue(TEXT("sizeZ"), 1.0);
+            if (ObjectiveIndex % 3 == 0)
+            {
+                Writer->WriteNull(TEXT("initialFactionIndex"));
+            }
+            else
+            {
+                Writer->WriteValue(TEXT("initialFactionIndex"), static_cast<double>(ObjectiveIndex % 4));
+            }
+            Writer->WriteArrayStart(TEXT("linkedObjectiveIndexes"));
+            for (int32 LinkIndex = 0; LinkIndex < 4; LinkIndex++)
+            {
+                Writer->WriteValue(Random.RandRange(0, NumObjectives - 1));
+            }
+            Writer->WriteArrayEnd();
+            Writer->WriteValue(TEXT("areaIndex"), ObjectiveIndex / 50);
+            Writer->WriteObjectEnd();
+        }
+        Writer->WriteArrayEnd();
+        Writer->Close();
+
+        return JsonString;
+    }
+
+    static void Run(const TArray<FString>& Args)
+    {
+        const int32 NumObjectives = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 5000;
+        const int32 Iterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 20;
+
+        const FString JsonString = CreateObjectivesJson(NumObjectives);
+        const FTCHARToUTF8 Utf8Json(*JsonString);
+        const TArray<uint8> Uncompressed(reinterpret_cast<const uint8*>(Utf8Json.Get()), Utf8Json.Length());
+
+        TArray<uint8> Compressed;
+        TArray<uint8> Roundtrip;
+
+        double CompressSeconds = 0;
+        double UncompressSeconds = 0;
+        for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+        {
+            const double CompressStartTime = FPlatformTime::Seconds();
+            if (!FAdhocManagerClient::GzipCompress(Uncompressed, Compressed))
+            {
+                UE_LOG(LogAdhocCompressionBenchmark, Error, TEXT("Compression failed"));
+                return;
+            }
+            CompressSeconds += FPlatformTime::Seconds() - CompressStartTime;
+
+            const double UncompressStartTime = FPlatformTime::Seconds();
+            if (!FAdhocManagerClient::GzipUncompress(Compressed, Roundtrip))
+            {
+                UE_LOG(LogAdhocCompressionBenchmark, Error, TEXT("Uncompression failed"));
+                return;
+            }
+            UncompressSeconds += FPlatformTime::Seconds() - UncompressStartTime;
+        }
+
+        if (Roundtrip != Uncompressed)
+        {
+            UE_LOG(LogAdhocCompressionBenchmark, Error, TEXT("Roundtrip mismatch"));
+            return;
+        }
+
+        const double CompressMs = CompressSeconds * 1000 / Iterations;
+        const double UncompressMs = UncompressSeconds * 1000 / Iterations;
+
+        UE_LOG(LogAdhocCompressionBenchmark, Display, TEXT("Objectives=%d Iterations=%d Uncompressed=%d bytes Compressed=%d bytes Ratio=%.2f Compress=%.3fms Uncompress=%.3fms"),
+            NumObjectives, Iterations, Uncompressed.Num(), Compressed.Num(), static_cast<double>(Uncompressed.Num()) / Compressed.Num(), CompressMs, UncompressMs);
+
+        // time to put the bytes on the wire at a few link speeds vs. the CPU spent compressing + uncompressing
+        for (const double Mbps : {10.0, 100.0, 1000.0})
+        {
+            const double UncompressedTransferMs = Uncompressed.Num() * 8 / (Mbps * 1000);
+            const double CompressedTransferMs = Compressed.Num() * 8 / (Mbps * 1000) + CompressMs + UncompressMs;
+            UE_LOG(LogAdhocCompressionBenchmark, Display, TEXT("  at %.0f Mbit/s: uncompressed %.3fms vs. compressed (including CPU) %.3fms"),
+                Mbps, UncompressedTransferMs, CompressedTransferMs);
+        }
+    }
+
+    static FAutoConsoleCommand BenchmarkCommand(
+        TEXT("Adhoc.Benchmark.Compression"),
+        TEXT("Gzip a synthetic objectives submission and report bytes and CPU time (correctness is covered by the Adhoc.Manager.Client.Gzip automation test). Usage: Adhoc.Benchmark.Compression [NumObjectives=5000] [Iterations=20]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&Run));
+}
+
+#endif
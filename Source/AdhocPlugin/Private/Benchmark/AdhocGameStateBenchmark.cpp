@@ -0,0 +1,584 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Game/AdhocGameStateComponent.h"
+#include "Manager/AdhocManagerJson.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if !UE_BUILD_SHIPPING
+
+DEFINE_LOG_CATEGORY_STATIC(LogAdhocGameStateBenchmark, Log, All);
+
+namespace AdhocGameStateBenchmark
+{
+    struct FParams
+    {
+        int32 NumFactions = 4;
+        int32 NumAreas = 64;
+        int32 NumObjectives = 2000;
+        int32 NumLinks = 4;
+        int32 NumServers = 16;
+        int32 NumStructures = 20000;
+        int32 NumPawns = 500;
+        int32 Iterations = 20;
+        int32 Seed = 1;
+        FString OutputFile;
+    };
+
+    struct FResult
+    {
+        FString Name;
+        /** Calls timed per iteration (so per call time can be compared across state sizes). */
+        int32 Calls = 0;
+        double MeanMs = 0;
+        double MinMs = 0;
+        double MaxMs = 0;
+        int32 Bytes = 0;
+    };
+
+    /** Accumulates results of timed calls so the optimizer cannot drop them. */
+    static int64 Checksum = 0;
+
+    static constexpr double AreaSize = 100000;
+
+    template <typename FunctionType>
+    static void Measure(TArray<FResult>& Results, const FParams& Params, const TCHAR* Name, const int32 Calls, FunctionType&& Function)
+    {
+        FResult& Result = Results.AddDefaulted_GetRef();
+        Result.Name = Name;
+        Result.Calls = Calls;
+        Result.MinMs = TNumericLimits<double>::Max();
+
+        // one untimed warm up run
+        Function();
+
+        double TotalMs = 0;
+        for (int32 Iteration = 0; Iteration < Params.Iterations; Iteration++)
+        {
+            const double StartTime = FPlatformTime::Seconds();
+            Function();
+            const double Ms = (FPlatformTime::Seconds() - StartTime) * 1000;
+
+            TotalMs += Ms;
+            Result.MinMs = FMath::Min(Result.MinMs, Ms);
+            Result.MaxMs = FMath::Max(Result.MaxMs, Ms);
+        }
+        Result.MeanMs = TotalMs / Params.Iterations;
+
+        UE_LOG(LogAdhocGameStateBenchmark, Display, TEXT("%-40s Calls=%-7d Mean=%.3fms Min=%.3fms Max=%.3fms PerCall=%.3fus"),
+            Name, Calls, Result.MeanMs, Result.MinMs, Result.MaxMs, Calls > 0 ? Result.MeanMs * 1000 / Calls : 0.0);
+    }
+
+    /** Areas in a square grid (region 1) shared out between the servers in order, with server 1 owning the first block. */
+    static void CreateAreas(const FParams& Params, TArray<FAdhocAreaState>& OutAreas, TArray<FAdhocServerState>& OutServers)
+    {
+        const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Params.NumAreas)));
+        const int32 AreasPerServer = FMath::DivideAndRoundUp(Params.NumAreas, Params.NumServers);
+
+        OutServers.SetNum(Params.NumServers);
+        for (int32 ServerIndex = 0; ServerIndex < Params.NumServers; ServerIndex++)
+        {
+            FAdhocServerState& Server = OutServers[ServerIndex];
+            Server.ID = ServerIndex + 1;
+            Server.Version = ServerIndex + 1;
+            Server.RegionID = 1;
+            Server.bEnabled = true;
+            Server.bActive = true;
+            Server.PrivateIP = FString::Printf(TEXT("10.0.%d.%d"), ServerIndex / 256, ServerIndex % 256);
+            Server.PublicIP = Server.PrivateIP;
+            Server.PublicWebSocketPort = 8889;
+        }
+
+        OutAreas.SetNum(Params.NumAreas);
+        for (int32 AreaIndex = 0; AreaIndex < Params.NumAreas; AreaIndex++)
+        {
+            FAdhocAreaState& Area = OutAreas[AreaIndex];
+            Area.ID = AreaIndex + 1;
+            Area.Version = AreaIndex + 1;
+            Area.RegionID = 1;
+            Area.Index = AreaIndex;
+            Area.Name = FString::Printf(TEXT("Area %d"), AreaIndex);
+            Area.Location = FVector((AreaIndex % GridSize) * AreaSize, (AreaIndex / GridSize) * AreaSize, 0);
+            Area.Size = FVector(AreaSize, AreaSize, AreaSize * 0.2);
+
+            FAdhocServerState& Server = OutServers[FMath::Min(AreaIndex / AreasPerServer, Params.NumServers - 1)];
+            Area.ServerID = Server.ID;
+            Server.AreaIDs.Add(Area.ID);
+            Server.AreaIndexes.Add(Area.Index);
+        }
+    }
+
+    static void CreateObjectives(const FParams& Params, const TArray<FAdhocAreaState>& Areas, FRandomStream& Random, TArray<FAdhocObjectiveState>& OutObjectives)
+    {
+        OutObjectives.SetNum(Params.NumObjectives);
+        for (int32 ObjectiveIndex = 0; ObjectiveIndex < Params.NumObjectives; ObjectiveIndex++)
+        {
+            const FAdhocAreaState& Area = Areas[ObjectiveIndex % Areas.Num()];
+
+            FAdhocObjectiveState& Objective = OutObjectives[ObjectiveIndex];
+            Objective.ID = ObjectiveIndex + 1;
+            Objective.Version = ObjectiveIndex + 1;
+            Objective.RegionID = 1;
+            Objective.Index = ObjectiveIndex;
+            Objective.Name = FString::Printf(TEXT("Objective %d"), ObjectiveIndex);
+            Objective.Location = Area.Location + FVector(Random.FRandRange(-0.5, 0.5) * Area.Size.X, Random.FRandRange(-0.5, 0.5) * Area.Size.Y, 0);
+            Objective.AreaID = Area.ID;
+            Objective.AreaIndex = Area.Index;
+
+            // a third start neutral
+            const int32 FactionIndex = ObjectiveIndex % 3 == 0 ? -1 : Random.RandRange(0, Params.NumFactions - 1);
+            Objective.InitialFactionIndex = FactionIndex;
+            Objective.InitialFactionID = FactionIndex == -1 ? -1 : FactionIndex + 1;
+            Objective.FactionIndex = FactionIndex;
+            Objective.FactionID = Objective.InitialFactionID;
+
+            for (int32 LinkIndex = 0; LinkIndex < Params.NumLinks; LinkIndex++)
+            {
+                const int32 LinkedObjectiveIndex = Random.RandRange(0, Params.NumObjectives - 1);
+                if (LinkedObjectiveIndex != ObjectiveIndex)
+                {
+                    Objective.LinkedObjectiveIndexes.AddUnique(LinkedObjectiveIndex);
+                    Objective.LinkedObjectiveIDs.AddUnique(LinkedObjectiveIndex + 1);
+                }
+            }
+        }
+    }
+
+    static void CreatePawns(const FParams& Params, const TArray<FAdhocAreaState>& Areas, FRandomStream& Random, TArray<FAdhocServerPawn>& OutPawns)
+    {
+        OutPawns.SetNum(Params.NumPawns);
+        for (int32 PawnIndex = 0; PawnIndex < Params.NumPawns; PawnIndex++)
+        {
+            const FAdhocAreaState& Area = Areas[PawnIndex % Areas.Num()];
+
+            FAdhocServerPawn& Pawn = OutPawns[PawnIndex];
+            Pawn.UUID = FGuid(Random.GetUnsignedInt(), Random.GetUnsignedInt(), Random.GetUnsignedInt(), Random.GetUnsignedInt());
+            Pawn.Name = FString::Printf(TEXT("Pawn%d"), PawnIndex);
+            Pawn.Description = TEXT("Synthetic pawn");
+            Pawn.Location = Area.Location + FVector(Random.FRandRange(-0.5, 0.5) * Area.Size.X, Random.FRandRange(-0.5, 0.5) * Area.Size.Y, 100);
+            Pawn.Rotation = FRotator(Random.FRandRange(-90, 90), Random.FRandRange(-180, 180), 0);
+            Pawn.bHuman = PawnIndex % 4 == 0;
+            Pawn.UserID = Pawn.bHuman ? PawnIndex + 1 : -1;
+            Pawn.FactionID = PawnIndex % Params.NumFactions + 1;
+        }
+    }
+
+    /** Manager responses in the shape the game mode parses (the submissions plus the manager assigned IDs / versions). */
+    static FString CreateFactionsResponse(const TArray<FAdhocFactionState>& Factions)
+    {
+        FString JsonString;
+        const auto& Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+        Writer->WriteArrayStart();
+        for (const FAdhocFactionState& Faction : Factions)
+        {
+            Writer->WriteObjectStart();
+            Writer->WriteValue(TEXT("id"), Faction.ID);
+            Writer->WriteValue(TEXT("version"), Faction.Version);
+            Writer->WriteValue(TEXT("index"), Faction.Index);
+            Writer->WriteValue(TEXT("name"), Faction.Name);
+            Writer->WriteValue(TEXT("color"), FString(TEXT("#")) + Faction.Color.ToHex());
+            Writer->WriteValue(TEXT("score"), Faction.Score);
+            Writer->WriteObjectEnd();
+        }
+        Writer->WriteArrayEnd();
+        Writer->Close();
+        return JsonString;
+    }
+
+    static FString CreateServersResponse(const TArray<FAdhocServerState>& Servers)
+    {
+        FString JsonString;
+        const auto& Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+        Writer->WriteArrayStart();
+        for (const FAdhocServerState& Server : Servers)
+        {
+            Writer->WriteObjectStart();
+            Writer->WriteValue(TEXT("id"), Server.ID);
+            Writer->WriteValue(TEXT("version"), Server.Version);
+            Writer->WriteValue(TEXT("regionId"), Server.RegionID);
+            Writer->WriteValue(TEXT("enabled"), Server.bEnabled);
+            Writer->WriteValue(TEXT("active"), Server.bActive);
+            Writer->WriteValue(TEXT("privateIP"), Server.PrivateIP);
+            Writer->WriteValue(TEXT("publicIP"), Server.PublicIP);
+            Writer->WriteValue(TEXT("publicWebSocketPort"), Server.PublicWebSocketPort);
+            Writer->WriteArrayStart(TEXT("areaIds"));
+            for (const auto Value : Server.AreaIDs)
+            {
+                Writer->WriteValue(Value);
+            }
+            Writer->WriteArrayEnd();
+            Writer->WriteArrayStart(TEXT("areaIndexes"));
+            for (const auto Value : Server.AreaIndexes)
+            {
+                Writer->WriteValue(Value);
+            }
+            Writer->WriteArrayEnd();
+            Writer->WriteObjectEnd();
+        }
+        Writer->WriteArrayEnd();
+        Writer->Close();
+        return JsonString;
+    }
+
+    static FString CreateAreasResponse(const TArray<FAdhocAreaState>& Areas)
+    {
+        FString JsonString;
+        const auto& Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+        Writer->WriteArrayStart();
+        for (const FAdhocAreaState& Area : Areas)
+        {
+            Writer->WriteObjectStart();
+            Writer->WriteValue(TEXT("id"), Area.ID);
+            Writer->WriteValue(TEXT("version"), Area.Version);
+            Writer->WriteValue(TEXT("regionId"), Area.RegionID);
+            Writer->WriteValue(TEXT("index"), Area.Index);
+            Writer->WriteValue(TEXT("name"), Area.Name);
+            Writer->WriteValue(TEXT("serverId"), Area.ServerID);
+            Writer->WriteObjectEnd();
+        }
+        Writer->WriteArrayEnd();
+        Writer->Close();
+        return JsonString;
+    }
+
+    static FString CreateObjectivesResponse(const TArray<FAdhocObjectiveState>& Objectives)
+    {
+        FString JsonString;
+        const auto& Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+        Writer->WriteArrayStart();
+        for (const FAdhocObjectiveState& Objective : Objectives)
+        {
+            Writer->WriteObjectStart();
+            Writer->WriteValue(TEXT("id"), Objective.ID);
+            Writer->WriteValue(TEXT("version"), Objective.Version);
+            Writer->WriteValue(TEXT("regionId"), Objective.RegionID);
+            Writer->WriteValue(TEXT("index"), Objective.Index);
+            Writer->WriteValue(TEXT("name"), Objective.Name);
+            if (Objective.FactionIndex != -1)
+            {
+                Writer->WriteValue(TEXT("initialFactionId"), Objective.InitialFactionID);
+                Writer->WriteValue(TEXT("initialFactionIndex"), Objective.InitialFactionIndex);
+                Writer->WriteValue(TEXT("factionId"), Objective.FactionID);
+                Writer->WriteValue(TEXT("factionIndex"), Objective.FactionIndex);
+            }
+            Writer->WriteArrayStart(TEXT("linkedObjectiveIds"));
+            for (const auto Value : Objective.LinkedObjectiveIDs)
+            {
+                Writer->WriteValue(Value);
+            }
+            Writer->WriteArrayEnd();
+            Writer->WriteArrayStart(TEXT("linkedObjectiveIndexes"));
+            for (const auto Value : Objective.LinkedObjectiveIndexes)
+            {
+                Writer->WriteValue(Value);
+            }
+            Writer->WriteArrayEnd();
+            Writer->WriteValue(TEXT("areaId"), Objective.AreaID);
+            Writer->WriteValue(TEXT("areaIndex"), Objective.AreaIndex);
+            Writer->WriteObjectEnd();
+        }
+        Writer->WriteArrayEnd();
+        Writer->Close();
+        return JsonString;
+    }
+
+    static FString ResultsToJson(const FParams& Params, const TArray<FResult>& Results)
+    {
+        FString JsonString;
+        const auto& Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("benchmark"), TEXT("GameState"));
+        Writer->WriteObjectStart(TEXT("params"));
+        Writer->WriteValue(TEXT("factions"), Params.NumFactions);
+        Writer->WriteValue(TEXT("areas"), Params.NumAreas);
+        Writer->WriteValue(TEXT("objectives"), Params.NumObjectives);
+        Writer->WriteValue(TEXT("links"), Params.NumLinks);
+        Writer->WriteValue(TEXT("servers"), Params.NumServers);
+        Writer->WriteValue(TEXT("structures"), Params.NumStructures);
+        Writer->WriteValue(TEXT("pawns"), Params.NumPawns);
+        Writer->WriteValue(TEXT("iterations"), Params.Iterations);
+        Writer->WriteValue(TEXT("seed"), Params.Seed);
+        Writer->WriteObjectEnd();
+        Writer->WriteArrayStart(TEXT("results"));
+        for (const FResult& Result : Results)
+        {
+            Writer->WriteObjectStart();
+            Writer->WriteValue(TEXT("name"), Result.Name);
+            Writer->WriteValue(TEXT("calls"), Result.Calls);
+            Writer->WriteValue(TEXT("meanMs"), Result.MeanMs);
+            Writer->WriteValue(TEXT("minMs"), Result.MinMs);
+            Writer->WriteValue(TEXT("maxMs"), Result.MaxMs);
+            Writer->WriteValue(TEXT("perCallUs"), Result.Calls > 0 ? Result.MeanMs * 1000 / Result.Calls : 0.0);
+            if (Result.Bytes > 0)
+            {
+                Writer->WriteValue(TEXT("bytes"), Result.Bytes);
+            }
+            Writer->WriteObjectEnd();
+        }
+        Writer->WriteArrayEnd();
+        Writer->WriteObjectEnd();
+        Writer->Close();
+        return JsonString;
+    }
+
+    static void Run(const TArray<FString>& Args)
+    {
+        const FString ParamsString = FString::Join(Args, TEXT(" "));
+
+        FParams Params;
+        FParse::Value(*ParamsString, TEXT("Factions="), Params.NumFactions);
+        FParse::Value(*ParamsString, TEXT("Areas="), Params.NumAreas);
+        FParse::Value(*ParamsString, TEXT("Objectives="), Params.NumObjectives);
+        FParse::Value(*ParamsString, TEXT("Links="), Params.NumLinks);
+        FParse::Value(*ParamsString, TEXT("Servers="), Params.NumServers);
+        FParse::Value(*ParamsString, TEXT("Structures="), Params.NumStructures);
+        FParse::Value(*ParamsString, TEXT("Pawns="), Params.NumPawns);
+        FParse::Value(*ParamsString, TEXT("Iterations="), Params.Iterations);
+        FParse::Value(*ParamsString, TEXT("Seed="), Params.Seed);
+        FParse::Value(*ParamsString, TEXT("Output="), Params.OutputFile);
+
+        Params.NumFactions = FMath::Max(1, Params.NumFactions);
+        Params.NumAreas = FMath::Max(1, Params.NumAreas);
+        Params.NumObjectives = FMath::Max(1, Params.NumObjectives);
+        Params.NumServers = FMath::Clamp(Params.NumServers, 1, Params.NumAreas);
+        Params.Iterations = FMath::Max(1, Params.Iterations);
+
+        FRandomStream Random(Params.Seed);
+
+        TArray<FAdhocFactionState> Factions;
+        Factions.SetNum(Params.NumFactions);
+        for (int32 FactionIndex = 0; FactionIndex < Params.NumFactions; FactionIndex++)
+        {
+            Factions[FactionIndex].ID = FactionIndex + 1;
+            Factions[FactionIndex].Version = FactionIndex + 1;
+            Factions[FactionIndex].Index = FactionIndex;
+            Factions[FactionIndex].Name = FString::Printf(TEXT("Faction %d"), FactionIndex);
+            Factions[FactionIndex].Color = FColor(Random.RandRange(0, 255), Random.RandRange(0, 255), Random.RandRange(0, 255));
+            Factions[FactionIndex].Score = 0;
+        }
+
+        TArray<FAdhocAreaState> Areas;
+        TArray<FAdhocServerState> Servers;
+        CreateAreas(Params, Areas, Servers);
+
+        TArray<FAdhocObjectiveState> Objectives;
+        CreateObjectives(Params, Areas, Random, Objectives);
+
+        TArray<FAdhocServerPawn> Pawns;
+        CreatePawns(Params, Areas, Random, Pawns);
+
+        const TStrongObjectPtr<UAdhocGameStateComponent> GameState(NewObject<UAdhocGameStateComponent>(GetTransientPackage()));
+        GameState->SetServerID(1);
+        GameState->SetRegionID(1);
+        GameState->SetFactions(Factions);
+        GameState->SetAreas(Areas);
+        GameState->SetObjectives(Objectives);
+        GameState->SetServers(Servers);
+        GameState->SetActiveAreaIndexes(Servers[0].AreaIndexes);
+
+        // query inputs are fixed up front so only the calls themselves are timed
+        const FVector WorldMax = Areas.Last().Location + Areas.Last().Size;
+        TArray<FVector> Locations;
+        Locations.SetNum(1000);
+        for (FVector& Location : Locations)
+        {
+            Location = FVector(Random.FRandRange(-AreaSize, WorldMax.X), Random.FRandRange(-AreaSize, WorldMax.Y), Random.FRandRange(0, 1000));
+        }
+
+        UE_LOG(LogAdhocGameStateBenchmark, Display, TEXT("Factions=%d Areas=%d Objectives=%d Links=%d Servers=%d Structures=%d Pawns=%d Iterations=%d Seed=%d"),
+            Params.NumFactions, Params.NumAreas, Params.NumObjectives, Params.NumLinks, Params.NumServers, Params.NumStructures, Params.NumPawns, Params.Iterations, Params.Seed);
+
+        TArray<FResult> Results;
+
+        Measure(Results, Params, TEXT("FindFactionByID"), Params.NumFactions, [&]
+        {
+            for (const FAdhocFactionState& Faction : Factions) { Checksum += GameState->FindFactionByID(Faction.ID) != nullptr; }
+        });
+        Measure(Results, Params, TEXT("FindAreaByID"), Params.NumAreas, [&]
+        {
+            for (const FAdhocAreaState& Area : Areas) { Checksum += GameState->FindAreaByID(Area.ID) != nullptr; }
+        });
+        Measure(Results, Params, TEXT("FindAreaByIndex"), Params.NumAreas, [&]
+        {
+            for (const FAdhocAreaState& Area : Areas) { Checksum += GameState->FindAreaByIndex(Area.Index) != nullptr; }
+        });
+        Measure(Results, Params, TEXT("FindObjectiveByID"), Params.NumObjectives, [&]
+        {
+            for (const FAdhocObjectiveState& Objective : Objectives) { Checksum += GameState->FindObjectiveByID(Objective.ID) != nullptr; }
+        });
+        Measure(Results, Params, TEXT("FindObjectiveByIndex"), Params.NumObjectives, [&]
+        {
+            for (const FAdhocObjectiveState& Objective : Objectives) { Checksum += GameState->FindObjectiveByIndex(Objective.Index) != nullptr; }
+        });
+        Measure(Results, Params, TEXT("FindServerByID"), Params.NumServers, [&]
+        {
+            for (const FAdhocServerState& Server : Servers) { Checksum += GameState->FindServerByID(Server.ID) != nullptr; }
+        });
+        Measure(Results, Params, TEXT("FindServerByAreaID"), Params.NumAreas, [&]
+        {
+            for (const FAdhocAreaState& Area : Areas) { Checksum += GameState->FindServerByAreaID(Area.ID) != nullptr; }
+        });
+        Measure(Results, Params, TEXT("FindAreaIndexByLocation"), Locations.Num(), [&]
+        {
+            for (const FVector& Location : Locations) { Checksum += GameState->FindAreaIndexByLocation(Location); }
+        });
+        Measure(Results, Params, TEXT("IsLocationNearActiveAreas"), Locations.Num(), [&]
+        {
+            for (const FVector& Location : Locations) { Checksum += GameState->IsLocationNearActiveAreas(Location, AreaSize * 0.5); }
+        });
+        Measure(Results, Params, TEXT("IsObjectiveActiveAndTakeableByFaction"), Params.NumObjectives * Params.NumFactions, [&]
+        {
+            for (const FAdhocObjectiveState& Objective : Objectives)
+            {
+                for (int32 FactionIndex = 0; FactionIndex < Params.NumFactions; FactionIndex++)
+                {
+                    Checksum += GameState->IsObjectiveActiveAndTakeableByFaction(Objective.Index, FactionIndex);
+                }
+            }
+        });
+        Measure(Results, Params, TEXT("GetNumActiveObjectivesByFactionIndex"), Params.NumFactions, [&]
+        {
+            for (int32 FactionIndex = 0; FactionIndex < Params.NumFactions; FactionIndex++)
+            {
+                Checksum += GameState->GetNumActiveObjectivesByFactionIndex(FactionIndex);
+            }
+        });
+
+#if WITH_ADHOC_PLUGIN_EXTRA
+        for (int32 StructureIndex = 0; StructureIndex < Params.NumStructures; StructureIndex++)
+        {
+            FAdhocStructureState Structure;
+            Structure.ID = StructureIndex + 1;
+            Structure.UUID = FGuid(Random.GetUnsignedInt(), Random.GetUnsignedInt(), Random.GetUnsignedInt(), Random.GetUnsignedInt());
+            Structure.RegionID = 1;
+            Structure.Location = FVector(Random.FRandRange(-AreaSize, WorldMax.X), Random.FRandRange(-AreaSize, WorldMax.Y), 0);
+            GameState->AddStructure(Structure);
+        }
+
+        TArray<const FAdhocStructureState*> FoundStructures;
+        Measure(Results, Params, TEXT("FindStructuresInBox"), Locations.Num(), [&]
+        {
+            for (const FVector& Location : Locations)
+            {
+                FoundStructures.Reset();
+                GameState->FindStructuresInBox(FBox::BuildAABB(Location, FVector(AreaSize * 0.25)), FoundStructures);
+                Checksum += FoundStructures.Num();
+            }
+        });
+#endif
+
+        // the builders / parsers the game mode uses for its manager exchanges
+        FString AreasJson;
+        Measure(Results, Params, TEXT("WriteAreas"), 1, [&]
+        {
+            AreasJson.Reset();
+            FAdhocManagerJson::WriteAreas(Areas, AreasJson);
+        });
+        Results.Last().Bytes = AreasJson.Len();
+
+        FString ObjectivesJson;
+        Measure(Results, Params, TEXT("WriteObjectives"), 1, [&]
+        {
+            ObjectivesJson.Reset();
+            FAdhocManagerJson::WriteObjectives(1, Objectives, ObjectivesJson);
+        });
+        Results.Last().Bytes = ObjectivesJson.Len();
+
+        FString ServerPawnsJson;
+        Measure(Results, Params, TEXT("WriteServerPawns"), 1, [&]
+        {
+            ServerPawnsJson.Reset();
+            FAdhocManagerJson::WriteServerPawns(1, Pawns, ServerPawnsJson);
+        });
+        Results.Last().Bytes = ServerPawnsJson.Len();
+
+        const FString FactionsResponse = CreateFactionsResponse(Factions);
+        TArray<FAdhocFactionState> ParsedFactions;
+        Measure(Results, Params, TEXT("ParseFactions"), 1, [&]
+        {
+            ParsedFactions.Reset();
+            Checksum += FAdhocManagerJson::ParseFactions(FactionsResponse, ParsedFactions);
+        });
+        Results.Last().Bytes = FactionsResponse.Len();
+
+        const FString ServersResponse = CreateServersResponse(Servers);
+        TArray<FAdhocServerState> ParsedServers;
+        Measure(Results, Params, TEXT("ParseServers"), 1, [&]
+        {
+            ParsedServers.Reset();
+            Checksum += FAdhocManagerJson::ParseServers(ServersResponse, ParsedServers);
+        });
+        Results.Last().Bytes = ServersResponse.Len();
+
+        const FString AreasResponse = CreateAreasResponse(Areas);
+        TArray<FAdhocAreaState> ParsedAreas;
+        Measure(Results, Params, TEXT("ParseAreas"), 1, [&]
+        {
+            ParsedAreas.Reset();
+            Checksum += FAdhocManagerJson::ParseAreas(AreasResponse, ParsedAreas);
+        });
+        Results.Last().Bytes = AreasResponse.Len();
+
+        const FString ObjectivesResponse = CreateObjectivesResponse(Objectives);
+        TArray<FAdhocObjectiveState> ParsedObjectives;
+        Measure(Results, Params, TEXT("ParseObjectives"), 1, [&]
+        {
+            ParsedObjectives.Reset();
+            Checksum += FAdhocManagerJson::ParseObjectives(ObjectivesResponse, ParsedObjectives);
+        });
+        Results.Last().Bytes = ObjectivesResponse.Len();
+
+        if (ParsedFactions.Num() != Factions.Num() || ParsedServers.Num() != Servers.Num() || ParsedAreas.Num() != Areas.Num() || ParsedObjectives.Num() != Objectives.Num())
+        {
+            UE_LOG(LogAdhocGameStateBenchmark, Error, TEXT("Parsed counts do not match the synthetic state"));
+        }
+
+        const FString ResultsJson = ResultsToJson(Params, Results);
+        UE_LOG(LogAdhocGameStateBenchmark, Display, TEXT("Results: %s"), *ResultsJson);
+        UE_LOG(LogAdhocGameStateBenchmark, Verbose, TEXT("Checksum=%lld"), Checksum);
+
+        if (!Params.OutputFile.IsEmpty())
+        {
+            if (FFileHelper::SaveStringToFile(ResultsJson, *Params.OutputFile))
+            {
+                UE_LOG(LogAdhocGameStateBenchmark, Display, TEXT("Saved results to %s"), *FPaths::ConvertRelativePathToFull(Params.OutputFile));
+            }
+            else
+            {
+                UE_LOG(LogAdhocGameStateBenchmark, Error, TEXT("Failed to save results to %s"), *Params.OutputFile);
+            }
+        }
+    }
+
+    static FAutoConsoleCommand BenchmarkCommand(
+        TEXT("Adhoc.Benchmark.GameState"),
+        TEXT("Time game state queries and manager JSON building / parsing against a synthetic state and log the results as JSON. ")
+        TEXT("Usage: Adhoc.Benchmark.GameState [Factions=4] [Areas=64] [Objectives=2000] [Links=4] [Servers=16] [Structures=20000] [Pawns=500] [Iterations=20] [Seed=1] [Output=File.json]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&Run));
+}
+
+#endif
@@ -0,0 +1,58 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Diagnostics/AdhocBodyLog.h"
+
+#include "HAL/IConsoleManager.h"
+
+#include <atomic>
+
+static int32 GAdhocBodyLogMaxChars = 1024;
+static FAutoConsoleVariableRef CVarAdhocBodyLogMaxChars(
+    TEXT("Adhoc.BodyLog.MaxChars"),
+    GAdhocBodyLogMaxChars,
+    TEXT("Maximum characters of a message body to include in Adhoc logging (0 = no limit)."));
+
+static int32 GAdhocBodyLogSampleEvery = 1;
+static FAutoConsoleVariableRef CVarAdhocBodyLogSampleEvery(
+    TEXT("Adhoc.BodyLog.SampleEvery"),
+    GAdhocBodyLogSampleEvery,
+    TEXT("Only log 1 in every N message bodies at verbose levels (1 = log every body)."));
+
+FString FAdhocBodyLog::Truncate(const FStringView Body)
+{
+    if (GAdhocBodyLogMaxChars <= 0 || Body.Len() <= GAdhocBodyLogMaxChars)
+    {
+        return FString(Body);
+    }
+
+    return FString::Printf(TEXT("%.*s... (%d more chars)"), GAdhocBodyLogMaxChars, Body.GetData(), Body.Len() - GAdhocBodyLogMaxChars);
+}
+
+bool FAdhocBodyLog::ShouldSample()
+{
+    if (GAdhocBodyLogSampleEvery <= 1)
+    {
+        return true;
+    }
+
+    static std::atomic<uint32> Counter{0};
+    return Counter.fetch_add(1, std::memory_order_relaxed) % static_cast<uint32>(GAdhocBodyLogSampleEvery) == 0;
+}
@@ -0,0 +1,556 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Diagnostics/AdhocLoadGeneratorComponent.h"
+
+#include "AIController.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "AI/AdhocAIControllerComponent.h"
+#include "Diagnostics/AdhocMetrics.h"
+#include "Diagnostics/AdhocProfiler.h"
+#include "Faction/AdhocFactionState.h"
+#include "Game/AdhocGameModeComponent.h"
+#include "Game/AdhocGameStateComponent.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/Pawn.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY(LogAdhocLoadGenerator)
+
+UAdhocLoadGeneratorComponent::UAdhocLoadGeneratorComponent(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    bWantsInitializeComponent = true;
+
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UAdhocLoadGeneratorComponent::InitializeComponent()
+{
+    Super::InitializeComponent();
+
+#if WITH_SERVER_CODE && !defined(__EMSCRIPTEN__)
+    FParse::Value(FCommandLine::Get(), TEXT("LoadBots="), NumBots);
+    FParse::Value(FCommandLine::Get(), TEXT("LoadBotSpawnRate="), BotSpawnRate);
+    FParse::Value(FCommandLine::Get(), TEXT("LoadBotSpeed="), BotSpeed);
+    FParse::Value(FCommandLine::Get(), TEXT("LoadWarmup="), Warmup);
+    FParse::Value(FCommandLine::Get(), TEXT("LoadDuration="), Duration);
+    FParse::Value(FCommandLine::Get(), TEXT("LoadCapturesPerMinute="), CapturesPerMinute);
+    FParse::Value(FCommandLine::Get(), TEXT("LoadDefeatsPerMinute="), DefeatsPerMinute);
+    FParse::Value(FCommandLine::Get(), TEXT("LoadEmissionsPerSecond="), EmissionsPerSecond);
+    FParse::Value(FCommandLine::Get(), TEXT("LoadReportInterval="), ReportInterval);
+    FParse::Value(FCommandLine::Get(), TEXT("LoadReportFile="), ReportFile);
+    FParse::Bool(FCommandLine::Get(), TEXT("LoadExitWhenDone="), bExitWhenDone);
+    FParse::Value(FCommandLine::Get(), TEXT("LoadSeed="), Seed);
+
+    UE_LOG(LogAdhocLoadGenerator, Log, TEXT("InitializeComponent: LoadBots=%d LoadBotSpawnRate=%f LoadBotSpeed=%f LoadWarmup=%f LoadDuration=%f LoadCapturesPerMinute=%f LoadDefeatsPerMinute=%f LoadEmissionsPerSecond=%f LoadReportInterval=%f LoadReportFile=%s LoadExitWhenDone=%d LoadSeed=%d"),
+        NumBots, BotSpawnRate, BotSpeed, Warmup, Duration, CapturesPerMinute, DefeatsPerMinute, EmissionsPerSecond, ReportInterval, *ReportFile, bExitWhenDone, Seed);
+
+    const AGameModeBase* GameMode = GetOwner<AGameModeBase>();
+    check(GameMode);
+
+    AdhocGameMode = Cast<UAdhocGameModeComponent>(GameMode->GetComponentByClass(UAdhocGameModeComponent::StaticClass()));
+    check(AdhocGameMode);
+
+    const AGameStateBase* GameState = GameMode->GetGameState<AGameStateBase>();
+    check(GameState);
+
+    AdhocGameState = Cast<UAdhocGameStateComponent>(GameState->GetComponentByClass(UAdhocGameStateComponent::StaticClass()));
+    check(AdhocGameState);
+
+#if !WITH_ADHOC_PLUGIN_EXTRA
+    if (EmissionsPerSecond > 0)
+    {
+        UE_LOG(LogAdhocLoadGenerator, Warning, TEXT("Emissions require the extra module - LoadEmissionsPerSecond will be ignored"));
+    }
+#endif
+#endif
+}
+
+void UAdhocLoadGeneratorComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+#if WITH_SERVER_CODE && !defined(__EMSCRIPTEN__)
+    Random.Initialize(Seed);
+    BeginPlayTime = FPlatformTime::Seconds();
+
+    if (ReportInterval > 0)
+    {
+        GetWorld()->GetTimerManager().SetTimer(TimerHandle_Report, this, &UAdhocLoadGeneratorComponent::OnTimer_Report, ReportInterval, true, ReportInterval);
+    }
+
+    SetComponentTickEnabled(true);
+#endif
+}
+
+void UAdhocLoadGeneratorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+#if WITH_SERVER_CODE && !defined(__EMSCRIPTEN__)
+    GetWorld()->GetTimerManager().ClearTimer(TimerHandle_Report);
+
+    if (StartTime >= 0 && !bFinished)
+    {
+        Finish();
+    }
+#endif
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UAdhocLoadGeneratorComponent::TickComponent(const float DeltaTime, const ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+#if WITH_SERVER_CODE && !defined(__EMSCRIPTEN__)
+    ADHOC_SCOPE(LoadGenerator);
+
+    const double Now = FPlatformTime::Seconds();
+    const float FrameMs = LastTickTime > 0 ? static_cast<float>((Now - LastTickTime) * 1000) : DeltaTime * 1000;
+    LastTickTime = Now;
+
+    if (Bots.Num() < NumBots)
+    {
+        SpawnAccumulator += BotSpawnRate * DeltaTime;
+        while (SpawnAccumulator >= 1 && Bots.Num() < NumBots)
+        {
+            SpawnAccumulator -= 1;
+            SpawnBot();
+        }
+    }
+
+    MoveBots(DeltaTime);
+
+    if (StartTime < 0)
+    {
+        if (Now - BeginPlayTime < Warmup)
+        {
+            return;
+        }
+        StartRecording();
+    }
+
+    if (bFinished)
+    {
+        return;
+    }
+
+    FrameTimes.Add(FrameMs);
+    ReportFrameTimes.Add(FrameMs);
+    FAdhocMetrics::Get().ObserveHistogram(TEXT("adhoc_loadgen_frame_seconds"), FString(), FrameMs);
+
+    // fractional events carry over so low rates still fire on average at the configured rate
+    CaptureAccumulator += CapturesPerMinute / 60.0 * DeltaTime;
+    for (; CaptureAccumulator >= 1; CaptureAccumulator -= 1)
+    {
+        TriggerCapture();
+    }
+
+    DefeatAccumulator += DefeatsPerMinute / 60.0 * DeltaTime;
+    for (; DefeatAccumulator >= 1; DefeatAccumulator -= 1)
+    {
+        TriggerDefeat();
+    }
+
+#if WITH_ADHOC_PLUGIN_EXTRA
+    EmissionAccumulator += EmissionsPerSecond * DeltaTime;
+    for (; EmissionAccumulator >= 1; EmissionAccumulator -= 1)
+    {
+        TriggerEmission();
+    }
+#endif
+
+    if (Duration > 0 && Now - StartTime >= Duration)
+    {
+        Finish();
+    }
+#endif
+}
+
+#if WITH_SERVER_CODE && !defined(__EMSCRIPTEN__)
+void UAdhocLoadGeneratorComponent::SpawnBot()
+{
+    UWorld* World = GetWorld();
+    check(World);
+
+    AGameModeBase* GameMode = GetOwner<AGameModeBase>();
+    check(GameMode);
+
+    if (Waypoints.Num() <= 0)
+    {
+        UpdateWaypoints();
+    }
+
+    FActorSpawnParameters SpawnParameters;
+    SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+    // the engine subsystem adds the AI controller component which joins the bot (via the bot pool if enabled) on the next tick
+    AAIController* Controller = World->SpawnActor<AAIController>(AAIController::StaticClass(), SpawnParameters);
+    if (!Controller)
+    {
+        UE_LOG(LogAdhocLoadGenerator, Warning, TEXT("Failed to spawn bot controller"));
+        return;
+    }
+
+    FBot& Bot = Bots.AddDefaulted_GetRef();
+    Bot.Controller = Controller;
+
+    UClass* PawnClass = GameMode->GetDefaultPawnClassForController(Controller);
+    if (!PawnClass)
+    {
+        return;
+    }
+
+    const FVector Location = Waypoints.Num() > 0
+        ? Waypoints[Random.RandHelper(Waypoints.Num())] + FVector(Random.FRandRange(-1000, 1000), Random.FRandRange(-1000, 1000), 0)
+        : FVector::ZeroVector;
+
+    APawn* Pawn = World->SpawnActor<APawn>(PawnClass, Location, FRotator::ZeroRotator, SpawnParameters);
+    if (!Pawn)
+    {
+        UE_LOG(LogAdhocLoadGenerator, Warning, TEXT("Failed to spawn bot pawn: PawnClass=%s"), *PawnClass->GetName());
+        return;
+    }
+
+    Controller->Possess(Pawn);
+    Bot.Pawn = Pawn;
+}
+
+void UAdhocLoadGeneratorComponent::UpdateWaypoints()
+{
+    Waypoints.Reset();
+
+    const TArray<int32>& ActiveAreaIndexes = AdhocGameState->GetActiveAreaIndexes();
+    for (const FAdhocObjectiveState& Objective : AdhocGameState->GetObjectives())
+    {
+        if (ActiveAreaIndexes.Contains(Objective.AreaIndex))
+        {
+            Waypoints.Add(Objective.Location);
+        }
+    }
+
+    if (Waypoints.Num() <= 0)
+    {
+        for (const int32 AreaIndex : ActiveAreaIndexes)
+        {
+            if (const FAdhocAreaState* Area = AdhocGameState->FindAreaByIndex(AreaIndex))
+            {
+                Waypoints.Add(Area->Location);
+            }
+        }
+    }
+
+    // not assigned any areas yet so just use every objective
+    if (Waypoints.Num() <= 0)
+    {
+        for (const FAdhocObjectiveState& Objective : AdhocGameState->GetObjectives())
+        {
+            Waypoints.Add(Objective.Location);
+        }
+    }
+}
+
+void UAdhocLoadGeneratorComponent::MoveBots(const float DeltaTime)
+{
+    if (Waypoints.Num() <= 0)
+    {
+        return;
+    }
+
+    const double Step = BotSpeed * DeltaTime;
+
+    for (FBot& Bot : Bots)
+    {
+        APawn* Pawn = Bot.Pawn.Get();
+        if (!Pawn)
+        {
+            continue;
+        }
+
+        if (!Waypoints.IsValidIndex(Bot.WaypointIndex))
+        {
+            Bot.WaypointIndex = Random.RandHelper(Waypoints.Num());
+            Bot.WaypointOffset = FVector(Random.FRandRange(-1000, 1000), Random.FRandRange(-1000, 1000), 0);
+        }
+
+        const FVector Location = Pawn->GetActorLocation();
+        const FVector ToTarget = Waypoints[Bot.WaypointIndex] + Bot.WaypointOffset - Location;
+        const double Distance = ToTarget.Size();
+
+        // teleport rather than sweep - we want the replication / event load of moving pawns, not the cost of their collision
+        if (Distance <= Step)
+        {
+            Pawn->SetActorLocation(Location + ToTarget, false, nullptr, ETeleportType::TeleportPhysics);
+            Bot.WaypointIndex = -1;
+        }
+        else
+        {
+            Pawn->SetActorLocationAndRotation(Location + ToTarget * (Step / Distance), ToTarget.Rotation(), false, nullptr, ETeleportType::TeleportPhysics);
+        }
+    }
+}
+
+void UAdhocLoadGeneratorComponent::TriggerCapture()
+{
+    const TArray<FAdhocObjectiveState>& Objectives = AdhocGameState->GetObjectives();
+    const int32 NumFactions = AdhocGameState->GetNumFactions();
+    if (Objectives.Num() <= 0 || NumFactions <= 0)
+    {
+        return;
+    }
+
+    // try a few random objective / faction pairs rather than searching for every takeable objective each time
+    for (int32 Attempt = 0; Attempt < 8; Attempt++)
+    {
+        const int32 ObjectiveIndex = Objectives[Random.RandHelper(Objectives.Num())].Index;
+        const int32 FactionIndex = Random.RandHelper(NumFactions);
+
+        if (AdhocGameState->IsObjectiveActiveAndTakeableByFaction(ObjectiveIndex, FactionIndex))
+        {
+            FAdhocObjectiveState* Objective = AdhocGameState->FindObjectiveByIndex(ObjectiveIndex);
+            check(Objective);
+
+            AdhocGameMode->ObjectiveTaken(*Objective, AdhocGameState->GetFaction(FactionIndex));
+
+            NumCaptures++;
+            FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_loadgen_events_total"), FAdhocMetrics::Label(TEXT("event"), TEXT("capture")));
+            return;
+        }
+    }
+}
+
+void UAdhocLoadGeneratorComponent::TriggerDefeat()
+{
+    // only bots which have joined have a user to report the defeat against
+    TArray<AController*, TInlineAllocator<64>> JoinedControllers;
+    for (const FBot& Bot : Bots)
+    {
+        AAIController* Controller = Bot.Controller.Get();
+        if (!Controller)
+        {
+            continue;
+        }
+
+        const UAdhocControllerComponent* AdhocController = Cast<UAdhocControllerComponent>(Controller->GetComponentByClass(UAdhocControllerComponent::StaticClass()));
+        if (AdhocController && AdhocController->GetUserID() >= 0)
+        {
+            JoinedControllers.Add(Controller);
+        }
+    }
+
+    if (JoinedControllers.Num() < 2)
+    {
+        return;
+    }
+
+    const int32 ControllerIndex = Random.RandHelper(JoinedControllers.Num());
+    const int32 DefeatedControllerIndex = (ControllerIndex + 1 + Random.RandHelper(JoinedControllers.Num() - 1)) % JoinedControllers.Num();
+
+    AdhocGameMode->UserDefeat(JoinedControllers[ControllerIndex], JoinedControllers[DefeatedControllerIndex]);
+
+    NumDefeats++;
+    FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_loadgen_events_total"), FAdhocMetrics::Label(TEXT("event"), TEXT("defeat")));
+}
+
+#if WITH_ADHOC_PLUGIN_EXTRA
+void UAdhocLoadGeneratorComponent::TriggerEmission()
+{
+    static const FName EmissionCategory(TEXT("LoadGenerator"));
+    static const FName EmissionType(TEXT("Explosion"));
+
+    if (Bots.Num() <= 0)
+    {
+        return;
+    }
+
+    const APawn* Pawn = Bots[Random.RandHelper(Bots.Num())].Pawn.Get();
+    if (!Pawn)
+    {
+        return;
+    }
+
+    AdhocGameMode->AddEmission(EmissionCategory, EmissionType, Pawn->GetActorLocation(), Pawn->GetActorRotation());
+
+    NumEmissions++;
+    FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_loadgen_events_total"), FAdhocMetrics::Label(TEXT("event"), TEXT("emission")));
+}
+#endif
+
+void UAdhocLoadGeneratorComponent::StartRecording()
+{
+    StartTime = FPlatformTime::Seconds();
+    ReportTime = StartTime;
+    StartBytesSent = GetBytesSent();
+    ReportBytesSent = StartBytesSent;
+
+    UpdateWaypoints();
+
+    UE_LOG(LogAdhocLoadGenerator, Log, TEXT("Recording started: Bots=%d Waypoints=%d"), Bots.Num(), Waypoints.Num());
+}
+
+void UAdhocLoadGeneratorComponent::Finish()
+{
+    bFinished = true;
+
+    const FString ReportJson = ReportToJson();
+    UE_LOG(LogAdhocLoadGenerator, Log, TEXT("Report: %s"), *ReportJson);
+
+    if (!ReportFile.IsEmpty())
+    {
+        if (FFileHelper::SaveStringToFile(ReportJson, *ReportFile))
+        {
+            UE_LOG(LogAdhocLoadGenerator, Log, TEXT("Saved report to %s"), *FPaths::ConvertRelativePathToFull(ReportFile));
+        }
+        else
+        {
+            UE_LOG(LogAdhocLoadGenerator, Error, TEXT("Failed to save report to %s"), *ReportFile);
+        }
+    }
+
+    if (bExitWhenDone && !GIsEditor && !IsEngineExitRequested())
+    {
+        UE_LOG(LogAdhocLoadGenerator, Log, TEXT("Load generation finished - requesting exit"));
+        FPlatformMisc::RequestExit(false);
+    }
+}
+
+void UAdhocLoadGeneratorComponent::OnTimer_Report()
+{
+    int32 NumJoined = 0;
+    for (const FBot& Bot : Bots)
+    {
+        const AAIController* Controller = Bot.Controller.Get();
+        const UAdhocControllerComponent* AdhocController = Controller
+            ? Cast<UAdhocControllerComponent>(Controller->GetComponentByClass(UAdhocControllerComponent::StaticClass()))
+            : nullptr;
+        if (AdhocController && AdhocController->GetUserID() >= 0)
+        {
+            NumJoined++;
+        }
+    }
+
+    FAdhocMetrics::Get().SetGauge(TEXT("adhoc_loadgen_bots"), FString(), Bots.Num());
+    FAdhocMetrics::Get().SetGauge(TEXT("adhoc_loadgen_bots_joined"), FString(), NumJoined);
+
+    // the active areas may have changed (e.g. assigned by the manager once the server started)
+    UpdateWaypoints();
+
+    if (StartTime < 0 || bFinished)
+    {
+        UE_LOG(LogAdhocLoadGenerator, Log, TEXT("Warming up: Bots=%d Joined=%d Waypoints=%d"), Bots.Num(), NumJoined, Waypoints.Num());
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    const double BytesSent = GetBytesSent();
+    const double Elapsed = FMath::Max(Now - ReportTime, 0.001);
+
+    UE_LOG(LogAdhocLoadGenerator, Log, TEXT("Bots=%d Joined=%d Frames=%d FrameP50Ms=%.2f FrameP99Ms=%.2f FrameMaxMs=%.2f BytesSentPerSecond=%.0f Captures=%lld Defeats=%lld Emissions=%lld"),
+        Bots.Num(), NumJoined, ReportFrameTimes.Count, ReportFrameTimes.GetPercentileMs(0.5), ReportFrameTimes.GetPercentileMs(0.99), ReportFrameTimes.MaxMs,
+        (BytesSent - ReportBytesSent) / Elapsed, NumCaptures, NumDefeats, NumEmissions);
+
+    ReportFrameTimes.Reset();
+    ReportBytesSent = BytesSent;
+    ReportTime = Now;
+}
+
+double UAdhocLoadGeneratorComponent::GetBytesSent()
+{
+    const FAdhocMetrics& Metrics = FAdhocMetrics::Get();
+    return Metrics.GetCounterTotal(TEXT("adhoc_stomp_bytes_sent_total")) + Metrics.GetCounterTotal(TEXT("adhoc_manager_request_bytes_total"));
+}
+
+void UAdhocLoadGeneratorComponent::FFrameTimeHistogram::Add(const float FrameMs)
+{
+    if (BucketCounts.Num() <= 0)
+    {
+        BucketCounts.SetNumZeroed(NumBuckets);
+    }
+
+    BucketCounts[FMath::Clamp(FMath::FloorToInt32(FrameMs / BucketWidthMs), 0, NumBuckets - 1)]++;
+    Count++;
+    SumMs += FrameMs;
+    MaxMs = FMath::Max(MaxMs, FrameMs);
+}
+
+void UAdhocLoadGeneratorComponent::FFrameTimeHistogram::Reset()
+{
+    FMemory::Memzero(BucketCounts.GetData(), BucketCounts.Num() * sizeof(int32));
+    Count = 0;
+    SumMs = 0;
+    MaxMs = 0;
+}
+
+float UAdhocLoadGeneratorComponent::FFrameTimeHistogram::GetPercentileMs(const double Percentile) const
+{
+    if (Count <= 0)
+    {
+        return 0;
+    }
+
+    const int32 Target = FMath::Clamp(FMath::CeilToInt32(Count * Percentile), 1, Count);
+
+    int32 Cumulative = 0;
+    for (int32 BucketIndex = 0; BucketIndex < NumBuckets - 1; BucketIndex++)
+    {
+        Cumulative += BucketCounts[BucketIndex];
+        if (Cumulative >= Target)
+        {
+            return FMath::Min((BucketIndex + 1) * BucketWidthMs, MaxMs);
+        }
+    }
+
+    return MaxMs;
+}
+
+FString UAdhocLoadGeneratorComponent::ReportToJson()
+{
+    const double Seconds = FMath::Max(FPlatformTime::Seconds() - StartTime, 0.001);
+    const double BytesSent = GetBytesSent() - StartBytesSent;
+
+    FString JsonString;
+    const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+        TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("bots"), Bots.Num());
+    Writer->WriteValue(TEXT("seconds"), Seconds);
+    Writer->WriteValue(TEXT("frames"), FrameTimes.Count);
+    Writer->WriteValue(TEXT("frameMeanMs"), FrameTimes.Count > 0 ? FrameTimes.SumMs / FrameTimes.Count : 0.0);
+    Writer->WriteValue(TEXT("frameP50Ms"), FrameTimes.GetPercentileMs(0.5));
+    Writer->WriteValue(TEXT("frameP90Ms"), FrameTimes.GetPercentileMs(0.9));
+    Writer->WriteValue(TEXT("frameP99Ms"), FrameTimes.GetPercentileMs(0.99));
+    Writer->WriteValue(TEXT("frameMaxMs"), FrameTimes.MaxMs);
+    Writer->WriteValue(TEXT("bytesSent"), BytesSent);
+    Writer->WriteValue(TEXT("bytesSentPerSecond"), BytesSent / Seconds);
+    Writer->WriteValue(TEXT("captures"), NumCaptures);
+    Writer->WriteValue(TEXT("defeats"), NumDefeats);
+    Writer->WriteValue(TEXT("emissions"), NumEmissions);
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    return JsonString;
+}
+#endif
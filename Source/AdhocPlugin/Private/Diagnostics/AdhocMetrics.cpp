@@ -0,0 +1,288 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Diagnostics/AdhocMetrics.h"
+
+#include "Misc/FileHelper.h"
+
+#if WITH_SERVER_CODE && !defined(__EMSCRIPTEN__)
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "Misc/ConfigCacheIni.h"
+#endif
+
+DEFINE_LOG_CATEGORY(LogAdhocMetrics)
+
+const double FAdhocLatencyHistogram::BucketUpperBoundsMs[NumBuckets - 1] = {1, 2, 5, 10, 25, 50, 100, 250, 500, 1000, 2500};
+
+void FAdhocLatencyHistogram::Add(const double LatencyMs)
+{
+    int32 BucketIndex = 0;
+    while (BucketIndex < NumBuckets - 1 && LatencyMs > BucketUpperBoundsMs[BucketIndex])
+    {
+        BucketIndex++;
+    }
+
+    BucketCounts[BucketIndex]++;
+    Count++;
+    SumMs += LatencyMs;
+    MaxMs = FMath::Max(MaxMs, LatencyMs);
+}
+
+double FAdhocLatencyHistogram::GetPercentileMs(const double Percentile) const
+{
+    if (Count <= 0)
+    {
+        return 0;
+    }
+
+    const int64 Target = FMath::Max<int64>(1, FMath::CeilToInt64(Count * Percentile));
+
+    int64 Cumulative = 0;
+    for (int32 BucketIndex = 0; BucketIndex < NumBuckets - 1; BucketIndex++)
+    {
+        Cumulative += BucketCounts[BucketIndex];
+        if (Cumulative >= Target)
+        {
+            return BucketUpperBoundsMs[BucketIndex];
+        }
+    }
+
+    return MaxMs;
+}
+
+FAdhocMetrics& FAdhocMetrics::Get()
+{
+    static FAdhocMetrics Metrics;
+    return Metrics;
+}
+
+FAdhocMetrics::FScopedTimer::FScopedTimer(const TCHAR* InName, FString InLabels)
+    : Name(InName), Labels(MoveTemp(InLabels)), StartTime(FPlatformTime::Seconds())
+{
+}
+
+FAdhocMetrics::FScopedTimer::~FScopedTimer()
+{
+    Get().ObserveHistogram(Name, Labels, (FPlatformTime::Seconds() - StartTime) * 1000);
+}
+
+FString FAdhocMetrics::Label(const TCHAR* Key, const FString& Value)
+{
+    const FString EscapedValue = Value.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\"")).Replace(TEXT("\n"), TEXT("\\n"));
+    return FString::Printf(TEXT("%s=\"%s\""), Key, *EscapedValue);
+}
+
+FAdhocMetrics::FFamily& FAdhocMetrics::FindOrAddFamily(const TCHAR* Name, const EType Type)
+{
+    FFamily* Family = Families.Find(Name);
+    if (!Family)
+    {
+        Family = &Families.Add(Name);
+        Family->Type = Type;
+    }
+    ensureMsgf(Family->Type == Type, TEXT("Metric %s used as more than one type"), Name);
+    return *Family;
+}
+
+void FAdhocMetrics::IncrementCounter(const TCHAR* Name, const FString& Labels, const double Amount)
+{
+    FindOrAddFamily(Name, EType::Counter).Values.FindOrAdd(Labels) += Amount;
+}
+
+void FAdhocMetrics::SetCounter(const TCHAR* Name, const FString& Labels, const double Value)
+{
+    FindOrAddFamily(Name, EType::Counter).Values.Add(Labels, Value);
+}
+
+void FAdhocMetrics::SetGauge(const TCHAR* Name, const FString& Labels, const double Value)
+{
+    FindOrAddFamily(Name, EType::Gauge).Values.Add(Labels, Value);
+}
+
+void FAdhocMetrics::ObserveHistogram(const TCHAR* Name, const FString& Labels, const double ValueMs)
+{
+    FindOrAddFamily(Name, EType::Histogram).Histograms.FindOrAdd(Labels).Add(ValueMs);
+}
+
+double FAdhocMetrics::GetCounter(const TCHAR* Name, const FString& Labels) const
+{
+    const FFamily* Family = Families.Find(Name);
+    return Family ? Family->Values.FindRef(Labels) : 0;
+}
+
+double FAdhocMetrics::GetCounterTotal(const TCHAR* Name) const
+{
+    double Total = 0;
+    if (const FFamily* Family = Families.Find(Name))
+    {
+        for (const TPair<FString, double>& ValuePair : Family->Values)
+        {
+            Total += ValuePair.Value;
+        }
+    }
+    return Total;
+}
+
+FString FAdhocMetrics::ExportPrometheusText()
+{
+    OnCollect.Broadcast(*this);
+
+    Families.KeySort(TLess<FString>());
+
+    FString Text;
+    for (TPair<FString, FFamily>& FamilyPair : Families)
+    {
+        const FString& Name = FamilyPair.Key;
+        FFamily& Family = FamilyPair.Value;
+
+        switch (Family.Type)
+        {
+        case EType::Counter:
+        case EType::Gauge:
+            Text += FString::Printf(TEXT("# TYPE %s %s\n"), *Name, Family.Type == EType::Counter ? TEXT("counter") : TEXT("gauge"));
+            Family.Values.KeySort(TLess<FString>());
+            for (const TPair<FString, double>& ValuePair : Family.Values)
+            {
+                Text += ValuePair.Key.IsEmpty()
+                    ? FString::Printf(TEXT("%s %.17g\n"), *Name, ValuePair.Value)
+                    : FString::Printf(TEXT("%s{%s} %.17g\n"), *Name, *ValuePair.Key, ValuePair.Value);
+            }
+            break;
+
+        case EType::Histogram:
+            Text += FString::Printf(TEXT("# TYPE %s histogram\n"), *Name);
+            Family.Histograms.KeySort(TLess<FString>());
+            for (const TPair<FString, FAdhocLatencyHistogram>& HistogramPair : Family.Histograms)
+            {
+                const FString LabelPrefix = HistogramPair.Key.IsEmpty() ? FString() : HistogramPair.Key + TEXT(",");
+                const FAdhocLatencyHistogram& Histogram = HistogramPair.Value;
+
+                // exposition format buckets are cumulative (and in seconds)
+                int64 Cumulative = 0;
+                for (int32 BucketIndex = 0; BucketIndex < FAdhocLatencyHistogram::NumBuckets - 1; BucketIndex++)
+                {
+                    Cumulative += Histogram.BucketCounts[BucketIndex];
+                    Text += FString::Printf(TEXT("%s_bucket{%sle=\"%g\"} %lld\n"), *Name, *LabelPrefix, FAdhocLatencyHistogram::BucketUpperBoundsMs[BucketIndex] / 1000, Cumulative);
+                }
+                Text += FString::Printf(TEXT("%s_bucket{%sle=\"+Inf\"} %lld\n"), *Name, *LabelPrefix, Histogram.Count);
+
+                const FString Braces = HistogramPair.Key.IsEmpty() ? FString() : FString::Printf(TEXT("{%s}"), *HistogramPair.Key);
+                Text += FString::Printf(TEXT("%s_sum%s %.17g\n"), *Name, *Braces, Histogram.SumMs / 1000);
+                Text += FString::Printf(TEXT("%s_count%s %lld\n"), *Name, *Braces, Histogram.Count);
+            }
+            break;
+        }
+    }
+    return Text;
+}
+
+bool FAdhocMetrics::SaveToFile(const FString& FilePath)
+{
+    // write then move so a scraper never reads a partial file
+    const FString TempFilePath = FilePath + TEXT(".tmp");
+    if (!FFileHelper::SaveStringToFile(ExportPrometheusText(), *TempFilePath) || !IFileManager::Get().Move(*FilePath, *TempFilePath))
+    {
+        UE_LOG(LogAdhocMetrics, Warning, TEXT("Failed to save metrics to %s"), *FilePath);
+        return false;
+    }
+    return true;
+}
+
+#if WITH_SERVER_CODE && !defined(__EMSCRIPTEN__)
+static TSharedPtr<IHttpRouter> MetricsHttpRouter;
+static FHttpRouteHandle MetricsHttpRouteHandle;
+#endif
+
+bool FAdhocMetrics::StartHttpExport(const uint32 Port, const FString& BindAddress)
+{
+#if WITH_SERVER_CODE && !defined(__EMSCRIPTEN__)
+    StopHttpExport();
+
+    // the HTTP server binds every address unless told otherwise (which it reads from the engine config when the listener starts)
+    // so override it just while our listener starts rather than changing the config for everything else in the process
+    TArray<FString> OriginalListenerOverrides;
+    const bool bHadListenerOverrides = GConfig->GetArray(TEXT("HTTPServer.Listeners"), TEXT("ListenerOverrides"), OriginalListenerOverrides, GEngineIni) > 0;
+    TArray<FString> ListenerOverrides = OriginalListenerOverrides;
+    ListenerOverrides.RemoveAll([Port](const FString& Override) { return Override.Contains(FString::Printf(TEXT("Port=%u,"), Port)); });
+    ListenerOverrides.Add(FString::Printf(TEXT("(Port=%u,BindAddress=\"%s\")"), Port, *BindAddress));
+    GConfig->SetArray(TEXT("HTTPServer.Listeners"), TEXT("ListenerOverrides"), ListenerOverrides, GEngineIni);
+
+    FHttpServerModule& HttpServerModule = FHttpServerModule::Get();
+    MetricsHttpRouter = HttpServerModule.GetHttpRouter(Port, /* bFailOnBindFailure */ true);
+    if (MetricsHttpRouter.IsValid())
+    {
+        MetricsHttpRouteHandle = MetricsHttpRouter->BindRoute(FHttpPath(TEXT("/metrics")), EHttpServerRequestVerbs::VERB_GET,
+            FHttpRequestHandler::CreateLambda([](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+            {
+                OnComplete(FHttpServerResponse::Create(Get().ExportPrometheusText(), TEXT("text/plain; version=0.0.4")));
+                return true;
+            }));
+
+        HttpServerModule.StartAllListeners();
+    }
+
+    if (bHadListenerOverrides)
+    {
+        GConfig->SetArray(TEXT("HTTPServer.Listeners"), TEXT("ListenerOverrides"), OriginalListenerOverrides, GEngineIni);
+    }
+    else
+    {
+        GConfig->RemoveKey(TEXT("HTTPServer.Listeners"), TEXT("ListenerOverrides"), GEngineIni);
+    }
+
+    if (!MetricsHttpRouter.IsValid())
+    {
+        UE_LOG(LogAdhocMetrics, Warning, TEXT("Failed to bind metrics port %u"), Port);
+        return false;
+    }
+
+    UE_LOG(LogAdhocMetrics, Log, TEXT("Serving metrics on %s:%u"), *BindAddress, Port);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FAdhocMetrics::StopHttpExport()
+{
+#if WITH_SERVER_CODE && !defined(__EMSCRIPTEN__)
+    if (!MetricsHttpRouter.IsValid())
+    {
+        return;
+    }
+
+    if (MetricsHttpRouteHandle.IsValid())
+    {
+        MetricsHttpRouter->UnbindRoute(MetricsHttpRouteHandle);
+    }
+    MetricsHttpRouteHandle.Reset();
+    MetricsHttpRouter.Reset();
+
+    // NOTE: the listener is left running as the HTTP server module can only stop every listener (including ones that are not ours)
+#endif
+}
+
+void FAdhocMetrics::Reset()
+{
+    Families.Reset();
+}
@@ -0,0 +1,121 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Diagnostics/AdhocProfiler.h"
+
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAdhocProfiler, Log, All);
+
+bool FAdhocProfiler::bEnabled = false;
+
+static FAutoConsoleVariableRef CVarAdhocProfilerEnabled(
+    TEXT("Adhoc.Profiler.Enabled"),
+    FAdhocProfiler::bEnabled,
+    TEXT("Collect rolling per scope timings for Adhoc.Profile."));
+
+static FAutoConsoleCommand AdhocProfileCommand(
+    TEXT("Adhoc.Profile"),
+    TEXT("Log Adhoc per function timings over the last N seconds (default 10, max 60) - enable collection first with Adhoc.Profiler.Enabled 1. Usage: Adhoc.Profile [Seconds] | Adhoc.Profile reset"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        if (Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase))
+        {
+            FAdhocProfiler::Get().Reset();
+            return;
+        }
+        FAdhocProfiler::Get().LogSummary(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10);
+    }));
+
+FAdhocProfiler& FAdhocProfiler::Get()
+{
+    static FAdhocProfiler Profiler;
+    return Profiler;
+}
+
+void FAdhocProfiler::AddSample(const FName Name, const uint64 Cycles)
+{
+    if (!IsInGameThread())
+    {
+        return;
+    }
+
+    const int64 Second = static_cast<int64>(FPlatformTime::Seconds());
+
+    FSecond& Bucket = Entries.FindOrAdd(Name).Seconds[Second % MaxWindowSeconds];
+    if (Bucket.Second != Second)
+    {
+        Bucket = FSecond();
+        Bucket.Second = Second;
+    }
+    Bucket.Calls++;
+    Bucket.TotalCycles += Cycles;
+    Bucket.MaxCycles = FMath::Max(Bucket.MaxCycles, Cycles);
+}
+
+void FAdhocProfiler::LogSummary(const int32 WindowSeconds) const
+{
+    const int32 Window = FMath::Clamp(WindowSeconds, 1, MaxWindowSeconds);
+    const int64 OldestSecond = static_cast<int64>(FPlatformTime::Seconds()) - Window + 1;
+
+    struct FRow
+    {
+        FName Name;
+        int64 Calls = 0;
+        uint64 TotalCycles = 0;
+        uint64 MaxCycles = 0;
+    };
+    TArray<FRow> Rows;
+
+    for (const TPair<FName, FEntry>& EntryPair : Entries)
+    {
+        FRow Row;
+        Row.Name = EntryPair.Key;
+        for (const FSecond& Bucket : EntryPair.Value.Seconds)
+        {
+            if (Bucket.Second >= OldestSecond)
+            {
+                Row.Calls += Bucket.Calls;
+                Row.TotalCycles += Bucket.TotalCycles;
+                Row.MaxCycles = FMath::Max(Row.MaxCycles, Bucket.MaxCycles);
+            }
+        }
+        if (Row.Calls > 0)
+        {
+            Rows.Add(Row);
+        }
+    }
+
+    Rows.Sort([](const FRow& A, const FRow& B) { return A.TotalCycles > B.TotalCycles; });
+
+    UE_LOG(LogAdhocProfiler, Display, TEXT("Adhoc profile over last %d seconds (%d scopes):"), Window, Rows.Num());
+    UE_LOG(LogAdhocProfiler, Display, TEXT("%-40s %10s %12s %10s %10s %8s"), TEXT("Scope"), TEXT("Calls"), TEXT("TotalMs"), TEXT("AvgUs"), TEXT("MaxUs"), TEXT("Ms/s"));
+    for (const FRow& Row : Rows)
+    {
+        const double TotalMs = FPlatformTime::ToMilliseconds64(Row.TotalCycles);
+        UE_LOG(LogAdhocProfiler, Display, TEXT("%-40s %10lld %12.2f %10.1f %10.1f %8.3f"),
+            *Row.Name.ToString(), Row.Calls, TotalMs, TotalMs * 1000 / Row.Calls, FPlatformTime::ToMilliseconds64(Row.MaxCycles) * 1000, TotalMs / Window);
+    }
+}
+
+void FAdhocProfiler::Reset()
+{
+    Entries.Reset();
+}
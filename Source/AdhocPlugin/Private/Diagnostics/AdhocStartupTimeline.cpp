@@ -0,0 +1,138 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Diagnostics/AdhocStartupTimeline.h"
+
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+
+DEFINE_LOG_CATEGORY(LogAdhocStartupTimeline)
+
+FAdhocStartupTimeline::FScope::FScope(FAdhocStartupTimeline& InTimeline, FString InName, const FName InCategory)
+    : Timeline(InTimeline), Name(MoveTemp(InName)), Category(InCategory), StartTime(FPlatformTime::Seconds())
+{
+}
+
+FAdhocStartupTimeline::FScope::~FScope()
+{
+    Timeline.Add(Name, Category, StartTime, FPlatformTime::Seconds());
+}
+
+void FAdhocStartupTimeline::Add(const FString& Name, const FName Category, const double StartTime, const double EndTime, const FString& Detail)
+{
+    if (!IsRecording())
+    {
+        return;
+    }
+
+    FEntry& Entry = Entries.AddDefaulted_GetRef();
+    Entry.Name = Name;
+    Entry.Category = Category;
+    Entry.StartSeconds = StartTime - GStartTime;
+    Entry.DurationSeconds = EndTime - StartTime;
+    Entry.Detail = Detail;
+}
+
+void FAdhocStartupTimeline::BeginPhase(const FString& Name)
+{
+    if (IsRecording())
+    {
+        OpenPhaseStartTimes.Add(Name, FPlatformTime::Seconds());
+    }
+}
+
+void FAdhocStartupTimeline::EndPhase(const FString& Name, const FString& Detail)
+{
+    double StartTime;
+    if (OpenPhaseStartTimes.RemoveAndCopyValue(Name, StartTime))
+    {
+        Add(Name, TEXT("phase"), StartTime, FPlatformTime::Seconds(), Detail);
+    }
+}
+
+void FAdhocStartupTimeline::MarkReady()
+{
+    if (!IsRecording())
+    {
+        return;
+    }
+
+    // anything still open never finished before we became ready
+    const double Now = FPlatformTime::Seconds();
+    for (const TPair<FString, double>& OpenPhase : OpenPhaseStartTimes)
+    {
+        Add(OpenPhase.Key, TEXT("phase"), OpenPhase.Value, Now, TEXT("unfinished"));
+    }
+    OpenPhaseStartTimes.Reset();
+
+    ReadySeconds = Now - GStartTime;
+
+    Entries.StableSort([](const FEntry& A, const FEntry& B) { return A.StartSeconds < B.StartSeconds; });
+}
+
+void FAdhocStartupTimeline::LogReport() const
+{
+    UE_LOG(LogAdhocStartupTimeline, Log, TEXT("Startup timeline: ReadyMs=%.1f Entries=%d"), ReadySeconds * 1000, Entries.Num());
+
+    for (const FEntry& Entry : Entries)
+    {
+        UE_LOG(LogAdhocStartupTimeline, Log, TEXT("  %10.1f ms %+10.1f ms  %-6s %s %s"),
+            Entry.StartSeconds * 1000, Entry.DurationSeconds * 1000, *Entry.Category.ToString(), *Entry.Name, *Entry.Detail);
+    }
+}
+
+FString FAdhocStartupTimeline::ToJson() const
+{
+    FString JsonString;
+    const TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("readyMs"), ReadySeconds * 1000);
+    Writer->WriteArrayStart(TEXT("entries"));
+    for (const FEntry& Entry : Entries)
+    {
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("name"), Entry.Name);
+        Writer->WriteValue(TEXT("category"), Entry.Category.ToString());
+        Writer->WriteValue(TEXT("startMs"), Entry.StartSeconds * 1000);
+        Writer->WriteValue(TEXT("durationMs"), Entry.DurationSeconds * 1000);
+        if (!Entry.Detail.IsEmpty())
+        {
+            Writer->WriteValue(TEXT("detail"), Entry.Detail);
+        }
+        Writer->WriteObjectEnd();
+    }
+    Writer->WriteArrayEnd();
+    Writer->WriteObjectEnd();
+    Writer->Close();
+    return JsonString;
+}
+
+bool FAdhocStartupTimeline::SaveJson(const FString& FilePath) const
+{
+    if (!FFileHelper::SaveStringToFile(ToJson(), *FilePath))
+    {
+        UE_LOG(LogAdhocStartupTimeline, Warning, TEXT("Failed to save startup timeline to %s"), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogAdhocStartupTimeline, Log, TEXT("Saved startup timeline to %s"), *FilePath);
+    return true;
+}
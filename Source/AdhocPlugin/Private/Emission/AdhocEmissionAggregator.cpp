@@ -0,0 +1,64 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Emission/AdhocEmissionAggregator.h"
+
+bool FAdhocEmissionAggregator::Add(FAdhocEmissionBuffer& Buffer, const FAdhocEmissionTypeTable& TypeTable, const int64 ServerID, const uint16 TypeID, const FVector& Location,
+    const FRotator& Rotation, const FDateTime& Timestamp, const int32 AreaIndex, const int32 Count, const float Radius)
+{
+    const double TimeSinceBase = Buffer.Num() > 0 ? (Timestamp - Buffer.BaseTimestamp).GetTotalSeconds() : 0.0;
+
+    FCellKey CellKey;
+    CellKey.Category = TypeTable.GetCategory(TypeID);
+    CellKey.Cell = FIntVector(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize), FMath::FloorToInt32(Location.Z / CellSize));
+    CellKey.TimeSlice = FMath::FloorToInt32(TimeSinceBase / CellDuration);
+
+    if (const int32* ExistingIndex = CellIndexes.Find(CellKey))
+    {
+        const int32 Index = *ExistingIndex;
+        const int32 ExistingCount = Buffer.Counts[Index];
+        const int32 MergedCount = ExistingCount + Count;
+
+        // the merged emission sits at the (count weighted) centre and its radius covers both
+        const FVector3f ExistingLocation = Buffer.Locations[Index];
+        const FVector3f MergedLocation = (ExistingLocation * ExistingCount + FVector3f(Location) * Count) / MergedCount;
+        Buffer.Radii[Index] = FMath::Max(Buffer.Radii[Index] + FVector3f::Dist(ExistingLocation, MergedLocation), Radius + FVector3f::Dist(FVector3f(Location), MergedLocation));
+        Buffer.Locations[Index] = MergedLocation;
+        Buffer.Counts[Index] = MergedCount;
+
+        NumMerged += Count;
+        return true;
+    }
+
+    if (Buffer.Num() >= MaxEmissions)
+    {
+        NumDropped += Count;
+        return false;
+    }
+
+    CellIndexes.Add(CellKey, Buffer.Num());
+    Buffer.Add(ServerID, TypeID, Location, Rotation, Timestamp, AreaIndex, Count, Radius);
+    return true;
+}
+
+void FAdhocEmissionAggregator::Reset()
+{
+    CellIndexes.Reset();
+}
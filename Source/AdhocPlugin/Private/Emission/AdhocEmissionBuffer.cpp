@@ -0,0 +1,301 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Emission/AdhocEmissionBuffer.h"
+
+#include "Dom/JsonObject.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+uint16 FAdhocEmissionTypeTable::FindOrAdd(const FName Category, const FName Type)
+{
+    const TPair<FName, FName> Key(Category, Type);
+    if (const uint16* TypeID = TypeIDs.Find(Key))
+    {
+        return *TypeID;
+    }
+
+    if (Types.Num() >= InvalidTypeID)
+    {
+        return InvalidTypeID;
+    }
+
+    const uint16 NewTypeID = static_cast<uint16>(Types.Add(Key));
+    TypeIDs.Add(Key, NewTypeID);
+    return NewTypeID;
+}
+
+void FAdhocEmissionBuffer::Reset()
+{
+    BaseTimestamp = FDateTime();
+    RegionID = -1;
+
+    ServerIDs.Reset();
+    TypeIDs.Reset();
+    TimestampOffsetsMs.Reset();
+    Locations.Reset();
+    Rotations.Reset();
+    AreaIndexes.Reset();
+    Counts.Reset();
+    Radii.Reset();
+}
+
+void FAdhocEmissionBuffer::Add(const int64 ServerID, const uint16 TypeID, const FVector& Location, const FRotator& Rotation, const FDateTime& Timestamp, const int32 AreaIndex,
+    const int32 Count, const float Radius)
+{
+    if (Num() == 0)
+    {
+        BaseTimestamp = Timestamp;
+    }
+
+    ServerIDs.Add(ServerID);
+    TypeIDs.Add(TypeID);
+    TimestampOffsetsMs.Add(static_cast<int32>((Timestamp - BaseTimestamp).GetTotalMilliseconds()));
+    Locations.Add(FVector3f(Location));
+    Rotations.Add(FRotator3f(Rotation));
+    AreaIndexes.Add(AreaIndex);
+    Counts.Add(Count);
+    Radii.Add(Radius);
+}
+
+FAdhocBufferedEmission FAdhocEmissionBuffer::Get(const int32 Index) const
+{
+    FAdhocBufferedEmission Emission;
+    Emission.ServerID = ServerIDs[Index];
+    Emission.TypeID = TypeIDs[Index];
+    Emission.Location = FVector(Locations[Index]);
+    Emission.Rotation = FRotator(Rotations[Index]);
+    Emission.Timestamp = GetTimestamp(Index);
+    Emission.RegionID = RegionID;
+    Emission.AreaIndex = AreaIndexes[Index];
+    Emission.Count = Counts[Index];
+    Emission.Radius = Radii[Index];
+    return Emission;
+}
+
+void FAdhocEmissionBuffer::ToEmission(const FAdhocEmissionTypeTable& TypeTable, const FAdhocBufferedEmission& Emission, FAdhocEmission& OutEmission)
+{
+    OutEmission.ServerID = Emission.ServerID;
+    OutEmission.Category = TypeTable.GetCategory(Emission.TypeID).ToString();
+    OutEmission.Type = TypeTable.GetType(Emission.TypeID).ToString();
+    OutEmission.Location = Emission.Location;
+    OutEmission.Rotation = Emission.Rotation;
+    OutEmission.Timestamp = Emission.Timestamp;
+    OutEmission.RegionID = Emission.RegionID;
+    OutEmission.AreaIndex = Emission.AreaIndex;
+    OutEmission.Count = Emission.Count;
+    OutEmission.Radius = Emission.Radius;
+}
+
+void FAdhocEmissionBuffer::WriteEventJson(const FAdhocEmissionTypeTable& TypeTable, FString& OutJsonString) const
+{
+    // only the types actually used in this buffer are written (remapped to indexes into the written types array)
+    TArray<uint16> UsedTypeIDs;
+    TArray<int32> WrittenTypeIndexes;
+    WrittenTypeIndexes.Init(INDEX_NONE, TypeTable.Num());
+    for (const uint16 TypeID : TypeIDs)
+    {
+        if (WrittenTypeIndexes[TypeID] == INDEX_NONE)
+        {
+            WrittenTypeIndexes[TypeID] = UsedTypeIDs.Add(TypeID);
+        }
+    }
+
+    const auto& Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutJsonString);
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("eventType"), TEXT("Emissions"));
+    Writer->WriteValue(TEXT("baseTimestamp"), BaseTimestamp.ToIso8601());
+    Writer->WriteValue(TEXT("regionId"), RegionID);
+
+    Writer->WriteArrayStart(TEXT("types"));
+    for (const uint16 TypeID : UsedTypeIDs)
+    {
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("category"), TypeTable.GetCategory(TypeID).ToString());
+        Writer->WriteValue(TEXT("type"), TypeTable.GetType(TypeID).ToString());
+        Writer->WriteObjectEnd();
+    }
+    Writer->WriteArrayEnd();
+
+    Writer->WriteArrayStart(TEXT("serverIds"));
+    for (const int64 ServerID : ServerIDs)
+    {
+        Writer->WriteValue(ServerID);
+    }
+    Writer->WriteArrayEnd();
+
+    Writer->WriteArrayStart(TEXT("typeIndexes"));
+    for (const uint16 TypeID : TypeIDs)
+    {
+        Writer->WriteValue(WrittenTypeIndexes[TypeID]);
+    }
+    Writer->WriteArrayEnd();
+
+    Writer->WriteArrayStart(TEXT("timestampOffsets"));
+    for (const int32 TimestampOffsetMs : TimestampOffsetsMs)
+    {
+        Writer->WriteValue(TimestampOffsetMs);
+    }
+    Writer->WriteArrayEnd();
+
+    // x, y, z triples (y is flipped as in all other positions sent to the manager)
+    Writer->WriteArrayStart(TEXT("locations"));
+    for (const FVector3f& Location : Locations)
+    {
+        Writer->WriteValue(FMath::RoundToInt32(Location.X));
+        Writer->WriteValue(FMath::RoundToInt32(-Location.Y));
+        Writer->WriteValue(FMath::RoundToInt32(Location.Z));
+    }
+    Writer->WriteArrayEnd();
+
+    // pitch, yaw, roll triples
+    Writer->WriteArrayStart(TEXT("rotations"));
+    for (const FRotator3f& Rotation : Rotations)
+    {
+        Writer->WriteValue(FMath::RoundToInt32(Rotation.Pitch));
+        Writer->WriteValue(FMath::RoundToInt32(Rotation.Yaw));
+        Writer->WriteValue(FMath::RoundToInt32(Rotation.Roll));
+    }
+    Writer->WriteArrayEnd();
+
+    Writer->WriteArrayStart(TEXT("areaIndexes"));
+    for (const int32 AreaIndex : AreaIndexes)
+    {
+        Writer->WriteValue(AreaIndex);
+    }
+    Writer->WriteArrayEnd();
+
+    Writer->WriteArrayStart(TEXT("counts"));
+    for (const int32 Count : Counts)
+    {
+        Writer->WriteValue(Count);
+    }
+    Writer->WriteArrayEnd();
+
+    Writer->WriteArrayStart(TEXT("radii"));
+    for (const float Radius : Radii)
+    {
+        Writer->WriteValue(FMath::RoundToInt32(Radius));
+    }
+    Writer->WriteArrayEnd();
+
+    Writer->WriteObjectEnd();
+    Writer->Close();
+}
+
+bool FAdhocEmissionBuffer::IsBufferEventJson(const TSharedPtr<FJsonObject>& JsonObject)
+{
+    return JsonObject->HasTypedField<EJson::Array>(TEXT("typeIndexes"));
+}
+
+bool FAdhocEmissionBuffer::ReadEventJson(const TSharedPtr<FJsonObject>& JsonObject, FAdhocEmissionTypeTable& TypeTable)
+{
+    Reset();
+
+    const TArray<TSharedPtr<FJsonValue>>* TypeJsonValues;
+    const TArray<TSharedPtr<FJsonValue>>* ServerIDJsonValues;
+    const TArray<TSharedPtr<FJsonValue>>* TypeIndexJsonValues;
+    const TArray<TSharedPtr<FJsonValue>>* TimestampOffsetJsonValues;
+    const TArray<TSharedPtr<FJsonValue>>* LocationJsonValues;
+    const TArray<TSharedPtr<FJsonValue>>* RotationJsonValues;
+    const TArray<TSharedPtr<FJsonValue>>* AreaIndexJsonValues;
+    FString BaseTimestampString;
+    if (!JsonObject->TryGetStringField(TEXT("baseTimestamp"), BaseTimestampString)
+        || !FDateTime::ParseIso8601(*BaseTimestampString, BaseTimestamp)
+        || !JsonObject->TryGetArrayField(TEXT("types"), TypeJsonValues)
+        || !JsonObject->TryGetArrayField(TEXT("serverIds"), ServerIDJsonValues)
+        || !JsonObject->TryGetArrayField(TEXT("typeIndexes"), TypeIndexJsonValues)
+        || !JsonObject->TryGetArrayField(TEXT("timestampOffsets"), TimestampOffsetJsonValues)
+        || !JsonObject->TryGetArrayField(TEXT("locations"), LocationJsonValues)
+        || !JsonObject->TryGetArrayField(TEXT("rotations"), RotationJsonValues)
+        || !JsonObject->TryGetArrayField(TEXT("areaIndexes"), AreaIndexJsonValues))
+    {
+        return false;
+    }
+
+    const int32 NumEmissions = TypeIndexJsonValues->Num();
+    if (ServerIDJsonValues->Num() != NumEmissions || TimestampOffsetJsonValues->Num() != NumEmissions || LocationJsonValues->Num() != NumEmissions * 3
+        || RotationJsonValues->Num() != NumEmissions * 3 || AreaIndexJsonValues->Num() != NumEmissions)
+    {
+        return false;
+    }
+
+    // region is only present from senders which know it (otherwise the receiver looks it up from the server IDs)
+    if (!JsonObject->TryGetNumberField(TEXT("regionId"), RegionID))
+    {
+        RegionID = -1;
+    }
+
+    // counts / radii are only present if the sender aggregates
+    const TArray<TSharedPtr<FJsonValue>>* CountJsonValues = nullptr;
+    const TArray<TSharedPtr<FJsonValue>>* RadiusJsonValues = nullptr;
+    if (!JsonObject->TryGetArrayField(TEXT("counts"), CountJsonValues) || CountJsonValues->Num() != NumEmissions)
+    {
+        CountJsonValues = nullptr;
+    }
+    if (!JsonObject->TryGetArrayField(TEXT("radii"), RadiusJsonValues) || RadiusJsonValues->Num() != NumEmissions)
+    {
+        RadiusJsonValues = nullptr;
+    }
+
+    // map the event's type indexes to our own interned type IDs
+    TArray<uint16, TInlineAllocator<16>> EventTypeIDs;
+    for (const TSharedPtr<FJsonValue>& TypeJsonValue : *TypeJsonValues)
+    {
+        const TSharedPtr<FJsonObject>& TypeJsonObject = TypeJsonValue->AsObject();
+        if (!TypeJsonObject.IsValid())
+        {
+            return false;
+        }
+        EventTypeIDs.Add(TypeTable.FindOrAdd(FName(TypeJsonObject->GetStringField(TEXT("category"))), FName(TypeJsonObject->GetStringField(TEXT("type")))));
+    }
+
+    ServerIDs.Reserve(NumEmissions);
+    TypeIDs.Reserve(NumEmissions);
+    TimestampOffsetsMs.Reserve(NumEmissions);
+    Locations.Reserve(NumEmissions);
+    Rotations.Reserve(NumEmissions);
+    AreaIndexes.Reserve(NumEmissions);
+    Counts.Reserve(NumEmissions);
+    Radii.Reserve(NumEmissions);
+
+    for (int32 Index = 0; Index < NumEmissions; Index++)
+    {
+        const int32 EventTypeIndex = static_cast<int32>((*TypeIndexJsonValues)[Index]->AsNumber());
+        if (!EventTypeIDs.IsValidIndex(EventTypeIndex) || EventTypeIDs[EventTypeIndex] == FAdhocEmissionTypeTable::InvalidTypeID)
+        {
+            Reset();
+            return false;
+        }
+
+        ServerIDs.Add(static_cast<int64>((*ServerIDJsonValues)[Index]->AsNumber()));
+        TypeIDs.Add(EventTypeIDs[EventTypeIndex]);
+        TimestampOffsetsMs.Add(static_cast<int32>((*TimestampOffsetJsonValues)[Index]->AsNumber()));
+        Locations.Emplace(static_cast<float>((*LocationJsonValues)[Index * 3]->AsNumber()), static_cast<float>(-(*LocationJsonValues)[Index * 3 + 1]->AsNumber()),
+            static_cast<float>((*LocationJsonValues)[Index * 3 + 2]->AsNumber()));
+        Rotations.Emplace(static_cast<float>((*RotationJsonValues)[Index * 3]->AsNumber()), static_cast<float>((*RotationJsonValues)[Index * 3 + 1]->AsNumber()),
+            static_cast<float>((*RotationJsonValues)[Index * 3 + 2]->AsNumber()));
+        AreaIndexes.Add(static_cast<int32>((*AreaIndexJsonValues)[Index]->AsNumber()));
+        Counts.Add(CountJsonValues ? FMath::Max(1, static_cast<int32>((*CountJsonValues)[Index]->AsNumber())) : 1);
+        Radii.Add(RadiusJsonValues ? static_cast<float>((*RadiusJsonValues)[Index]->AsNumber()) : 0.0f);
+    }
+
+    return true;
+}
@@ -0,0 +1,62 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Emission/AdhocEmissionPlaybackQueue.h"
+
+bool FAdhocEmissionPlaybackQueue::Enqueue(const double DueTime, const FAdhocBufferedEmission& Emission)
+{
+    if (Heap.Num() >= MaxQueuedEmissions)
+    {
+        NumDropped++;
+        return false;
+    }
+
+    Heap.HeapPush(FEntry{DueTime, NextSequence++, Emission}, FEntryPredicate());
+    return true;
+}
+
+void FAdhocEmissionPlaybackQueue::Drain(const double Now, const TFunctionRef<void(const FAdhocBufferedEmission&)> PlayEmission)
+{
+    FEntry Entry;
+    while (Heap.Num() > 0 && Heap[0].DueTime <= Now)
+    {
+        Heap.HeapPop(Entry, FEntryPredicate());
+
+        const double Lateness = Now - Entry.DueTime;
+        if (Lateness > MaxLatenessSeconds)
+        {
+            NumDropped++;
+            continue;
+        }
+        if (Lateness > LateThresholdSeconds)
+        {
+            NumLate++;
+        }
+
+        NumPlayed++;
+        PlayEmission(Entry.Emission);
+    }
+}
+
+void FAdhocEmissionPlaybackQueue::Reset()
+{
+    NumDropped += Heap.Num();
+    Heap.Reset();
+}
@@ -24,6 +24,10 @@
 #include "Area/AdhocAreaComponent.h"
 #include "Faction/AdhocFactionState.h"
 #include "Game/AdhocGameStateComponent.h"
+#include "Diagnostics/AdhocBodyLog.h"
+#include "Diagnostics/AdhocLoadGeneratorComponent.h"
+#include "Diagnostics/AdhocProfiler.h"
+#include "Manager/AdhocManagerJson.h"
 #include "Pawn/AdhocPawnComponent.h"
 #include "Player/AdhocPlayerControllerComponent.h"
 #include "Player/AdhocPlayerStateComponent.h"
@@ -34,6 +38,7 @@
 #include "GameFramework/GameSession.h"
 #include "GameFramework/GameStateBase.h"
 #include "GameFramework/PlayerState.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
 #include "Runtime/Online/HTTP/Public/Http.h"
 #include "Runtime/Online/WebSockets/Public/WebSocketsModule.h"
 #include "Runtime/Online/Stomp/Public/IStompMessage.h"
@@ -41,11 +46,13 @@
 #include "Kismet/GameplayStatics.h"
 #include "Engine/NetConnection.h"
 #include "Misc/Base64.h"
+#include "Misc/SecureHash.h"
 #include "Objective/AdhocObjectiveComponent.h"
 #include "Policies/CondensedJsonPrintPolicy.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
+#include "Structure/AdhocStructureInterface.h"
 
 DEFINE_LOG_CATEGORY(LogAdhocGameModeComponent)
 
@@ -54,13 +61,19 @@ UAdhocGameModeComponent::UAdhocGameModeComponent(const FObjectInitializer& Objec
 {
     bWantsInitializeComponent = true;
 
-    PrimaryComponentTick.bCanEverTick = false;
+    // only ticks while there is queued work: emissions to play back, structures to parse / materialize or a recording to replay
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
 }
 
 void UAdhocGameModeComponent::InitializeComponent()
 {
     Super::InitializeComponent();
 
+#if WITH_SERVER_CODE && !defined(__EMSCRIPTEN__)
+    const double InitializeStartTime = FPlatformTime::Seconds();
+#endif
+
     int64 ServerID = 1;
     int64 RegionID = 1;
     FParse::Value(FCommandLine::Get(), TEXT("ServerID="), ServerID);
@@ -89,10 +102,58 @@ void UAdhocGameModeComponent::InitializeComponent()
 #endif
 
 #if WITH_SERVER_CODE && !defined(__EMSCRIPTEN__)
+    StartupTimeline.Add(TEXT("InitStates"), TEXT("phase"), InitializeStartTime, FPlatformTime::Seconds());
+
     FParse::Value(FCommandLine::Get(), TEXT("PrivateIP="), PrivateIP);
     FParse::Value(FCommandLine::Get(), TEXT("ManagerHost="), ManagerHost);
+    FParse::Value(FCommandLine::Get(), TEXT("ManagerPort="), ManagerPort);
+    FParse::Value(FCommandLine::Get(), TEXT("BotPoolSize="), BotPoolSize);
+    FParse::Bool(FCommandLine::Get(), TEXT("OptimisticAdmission="), bOptimisticAdmission);
+    FParse::Value(FCommandLine::Get(), TEXT("VerifiedUserCacheTTL="), VerifiedUserCacheTTL);
+    FParse::Value(FCommandLine::Get(), TEXT("ManagerMaxInFlightRequests="), ManagerMaxInFlightRequests);
+    FParse::Bool(FCommandLine::Get(), TEXT("ManagerCompressRequests="), bManagerCompressRequests);
+    FParse::Value(FCommandLine::Get(), TEXT("ManagerCompressMinBytes="), ManagerCompressMinBytes);
+    FParse::Bool(FCommandLine::Get(), TEXT("ManagerAcceptCompressedResponses="), bManagerAcceptCompressedResponses);
+    FParse::Value(FCommandLine::Get(), TEXT("EmissionRelevancyMargin="), EmissionRelevancyMargin);
+    FParse::Bool(FCommandLine::Get(), TEXT("EmissionBufferFormat="), bEmissionBufferFormat);
+    FParse::Bool(FCommandLine::Get(), TEXT("EmissionPlaybackQueue="), bEmissionPlaybackQueue);
+    FParse::Value(FCommandLine::Get(), TEXT("StructureMaterializationBudgetMs="), StructureMaterializationBudgetMs);
+    FParse::Value(FCommandLine::Get(), TEXT("StructureLiveMargin="), StructureLiveMargin);
+    FParse::Value(FCommandLine::Get(), TEXT("StructureDormantMargin="), StructureDormantMargin);
+    FParse::Bool(FCommandLine::Get(), TEXT("PagedStructureSync="), bPagedStructureSync);
+    FParse::Value(FCommandLine::Get(), TEXT("StructureSyncPageSize="), StructureSyncPageSize);
+    FParse::Value(FCommandLine::Get(), TEXT("StateResyncInterval="), StateResyncInterval);
+    FParse::Value(FCommandLine::Get(), TEXT("StateFullResyncEvery="), StateFullResyncEvery);
+    FParse::Bool(FCommandLine::Get(), TEXT("ScopedEventTopics="), bScopedEventTopics);
+    FParse::Value(FCommandLine::Get(), TEXT("StartupTimelineFile="), StartupTimelineFile);
+    FParse::Value(FCommandLine::Get(), TEXT("MetricsPort="), MetricsPort);
+    FParse::Value(FCommandLine::Get(), TEXT("MetricsBindAddress="), MetricsBindAddress);
+    FParse::Value(FCommandLine::Get(), TEXT("MetricsFile="), MetricsFile);
+    FParse::Value(FCommandLine::Get(), TEXT("MetricsFileInterval="), MetricsFileInterval);
+    FParse::Value(FCommandLine::Get(), TEXT("EventReorderDepth="), EventSequencer.MaxReorderDepth);
+    FParse::Value(FCommandLine::Get(), TEXT("EventReorderWait="), EventSequencer.MaxReorderWaitSeconds);
+    FParse::Value(FCommandLine::Get(), TEXT("EventResyncMinInterval="), EventResyncMinInterval);
+    FParse::Value(FCommandLine::Get(), TEXT("ManagerRecordFile="), ManagerRecordFile);
+    FParse::Value(FCommandLine::Get(), TEXT("ManagerReplayFile="), ManagerReplayFile);
+    FParse::Value(FCommandLine::Get(), TEXT("ManagerReplaySpeed="), ManagerReplaySpeed);
+    FParse::Bool(FCommandLine::Get(), TEXT("LoadGenerator="), bLoadGenerator);
 
-    UE_LOG(LogAdhocGameModeComponent, Log, TEXT("InitializeComponent: PrivateIP=%s ManagerHost=%s"), *PrivateIP, *ManagerHost);
+#if WITH_ADHOC_PLUGIN_EXTRA
+    // emissions outside our areas are aggregated much more coarsely than our own
+    DistantEmissionAggregator.CellSize = 5000;
+    DistantEmissionAggregator.CellDuration = 1;
+    DistantEmissionAggregator.MaxEmissions = 64;
+
+    FParse::Value(FCommandLine::Get(), TEXT("EmissionAggregationCellSize="), RecentEmissionAggregator.CellSize);
+    FParse::Value(FCommandLine::Get(), TEXT("EmissionAggregationCellDuration="), RecentEmissionAggregator.CellDuration);
+    FParse::Value(FCommandLine::Get(), TEXT("EmissionAggregationMaxEmissions="), RecentEmissionAggregator.MaxEmissions);
+    FParse::Value(FCommandLine::Get(), TEXT("DistantEmissionAggregationCellSize="), DistantEmissionAggregator.CellSize);
+#endif
+
+    UE_LOG(LogAdhocGameModeComponent, Log, TEXT("InitializeComponent: PrivateIP=%s ManagerHost=%s ManagerPort=%d BotPoolSize=%d OptimisticAdmission=%d VerifiedUserCacheTTL=%f ManagerMaxInFlightRequests=%d ManagerCompressRequests=%d ManagerCompressMinBytes=%d ManagerAcceptCompressedResponses=%d EmissionRelevancyMargin=%f EmissionBufferFormat=%d EmissionPlaybackQueue=%d StructureMaterializationBudgetMs=%f StructureLiveMargin=%f StructureDormantMargin=%f PagedStructureSync=%d StateResyncInterval=%f StateFullResyncEvery=%d ScopedEventTopics=%d EventReorderDepth=%d EventReorderWait=%f EventResyncMinInterval=%f MetricsPort=%d MetricsBindAddress=%s MetricsFile=%s ManagerRecordFile=%s ManagerReplayFile=%s ManagerReplaySpeed=%f LoadGenerator=%d"),
+        *PrivateIP, *ManagerHost, ManagerPort, BotPoolSize, bOptimisticAdmission, VerifiedUserCacheTTL, ManagerMaxInFlightRequests, bManagerCompressRequests, ManagerCompressMinBytes, bManagerAcceptCompressedResponses,
+        EmissionRelevancyMargin, bEmissionBufferFormat, bEmissionPlaybackQueue, StructureMaterializationBudgetMs, StructureLiveMargin, StructureDormantMargin, bPagedStructureSync, StateResyncInterval, StateFullResyncEvery, bScopedEventTopics,
+        EventSequencer.MaxReorderDepth, EventSequencer.MaxReorderWaitSeconds, EventResyncMinInterval, MetricsPort, *MetricsBindAddress, *MetricsFile, *ManagerRecordFile, *ManagerReplayFile, ManagerReplaySpeed, bLoadGenerator);
 
     BasicAuthPassword = FPlatformMisc::GetEnvironmentVariable(TEXT("SERVER_BASIC_AUTH_PASSWORD"));
     if (BasicAuthPassword.IsEmpty())
@@ -130,11 +191,65 @@ void UAdhocGameModeComponent::InitializeComponent()
     Http = &FHttpModule::Get();
     WebSockets = &FWebSocketsModule::Get();
     Stomp = &FStompModule::Get();
+
+    ManagerClient = MakeShared<FAdhocManagerClient>(ManagerHost, ManagerPort, BasicAuthHeaderValue);
+    ManagerClient->SetMaxInFlightRequests(ManagerMaxInFlightRequests);
+    ManagerClient->SetRequestCompression(bManagerCompressRequests, ManagerCompressMinBytes);
+    ManagerClient->SetAcceptCompressedResponses(bManagerAcceptCompressedResponses);
+    ManagerClient->SetOnRequestCompleted(FAdhocManagerRequestCompletedDelegate::CreateUObject(this, &UAdhocGameModeComponent::OnManagerRequestCompleted));
+
+    if (!ManagerReplayFile.IsEmpty())
+    {
+        // the recording stands in for the manager so nothing should actually be sent
+        ManagerClient->SetOffline(true);
+
+        if (!ManagerRecordFile.IsEmpty())
+        {
+            UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Cannot record while replaying - ignoring ManagerRecordFile=%s"), *ManagerRecordFile);
+        }
+    }
+    else if (!ManagerRecordFile.IsEmpty())
+    {
+        ManagerRecorder.Open(ManagerRecordFile);
+    }
+
+    // startup exchanges are worth waiting for (the server cannot start without them)
+    // NOTE: only the GETs are retried - the areas / objectives POSTs are not marked idempotent
+    FAdhocManagerEndpointSettings StartupEndpointSettings;
+    StartupEndpointSettings.TimeoutSeconds = 30;
+    StartupEndpointSettings.MaxRetries = 5;
+    StartupEndpointSettings.RetryDelaySeconds = 1;
+    for (const TCHAR* Endpoint : {TEXT("factions"), TEXT("servers"), TEXT("areas"), TEXT("objectives"), TEXT("userTokenKey"), TEXT("structures")})
+    {
+        ManagerClient->SetEndpointSettings(Endpoint, StartupEndpointSettings);
+    }
+
+    // a user is waiting on these so fail fast rather than leaving them hanging
+    // (and a join / navigate which timed out may have been applied by the manager so they are never retried)
+    FAdhocManagerEndpointSettings UserEndpointSettings;
+    UserEndpointSettings.TimeoutSeconds = 5;
+    UserEndpointSettings.MaxRetries = 0;
+    for (const TCHAR* Endpoint : {TEXT("userJoin"), TEXT("userNavigate")})
+    {
+        ManagerClient->SetEndpointSettings(Endpoint, UserEndpointSettings);
+    }
+
+    // the metrics singleton outlives each play in editor session so start every session afresh
+    FAdhocMetrics::Get().Reset();
+    MetricsCollectHandle = FAdhocMetrics::Get().OnCollect.AddUObject(this, &UAdhocGameModeComponent::OnCollectMetrics);
+    if (MetricsPort > 0)
+    {
+        FAdhocMetrics::Get().StartHttpExport(MetricsPort, MetricsBindAddress);
+    }
+
+    StartupTimeline.Add(TEXT("InitializeComponent"), TEXT("phase"), InitializeStartTime, FPlatformTime::Seconds());
 #endif
 }
 
 void UAdhocGameModeComponent::BeginPlay()
 {
+    const double BeginPlayStartTime = FPlatformTime::Seconds();
+
     Super::BeginPlay();
 
     UE_LOG(LogAdhocGameModeComponent, Log, TEXT("BeginPlay: NetMode=%d"), GetNetMode());
@@ -142,26 +257,52 @@ void UAdhocGameModeComponent::BeginPlay()
 #if WITH_SERVER_CODE && !defined(__EMSCRIPTEN__)
     if (GetNetMode() != NM_Client)
     {
-        // initiate stomp connection - only once we are sure this connection is established
-        // will we then do an initial push/refresh all world state via REST calls etc.
-        UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Initializing Stomp connection..."));
+#if WITH_ADHOC_PLUGIN_EXTRA
+        ActorSpawnedHandle = GetWorld()->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UAdhocGameModeComponent::OnActorSpawned));
+        ActorDestroyedHandle = GetWorld()->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &UAdhocGameModeComponent::OnActorDestroyed));
+#endif
+
+        if (!MetricsFile.IsEmpty() && MetricsFileInterval > 0)
+        {
+            GetWorld()->GetTimerManager().SetTimer(TimerHandle_MetricsFile, this, &UAdhocGameModeComponent::OnTimer_MetricsFile, MetricsFileInterval, true, MetricsFileInterval);
+        }
 
-        const FString& StompURL = FString::Printf(TEXT("ws://%s:80/adhoc_ws/stomp/server"), *ManagerHost);
-        StompClient = Stomp->CreateClient(StompURL, *BasicAuthHeaderValue);
+        if (!ManagerReplayFile.IsEmpty())
+        {
+            StartReplay();
+        }
+        else
+        {
+            // initiate stomp connection - only once we are sure this connection is established
+            // will we then do an initial push/refresh all world state via REST calls etc.
+            UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Initializing Stomp connection..."));
 
-        StompClient->OnConnected().AddUObject(this, &UAdhocGameModeComponent::OnStompConnected);
-        StompClient->OnConnectionError().AddUObject(this, &UAdhocGameModeComponent::OnStompConnectionError);
-        StompClient->OnError().AddUObject(this, &UAdhocGameModeComponent::OnStompError);
-        StompClient->OnClosed().AddUObject(this, &UAdhocGameModeComponent::OnStompClosed);
+            const FString& StompURL = FString::Printf(TEXT("ws://%s:%d/adhoc_ws/stomp/server"), *ManagerHost, ManagerPort);
+            StompClient = Stomp->CreateClient(StompURL, *BasicAuthHeaderValue);
 
-        // FStompHeader StompHeader;
-        // StompHeader.Add(TEXT("X-CSRF-TOKEN"), TEXT("SERVER"));
-        // StompHeader.Add(TEXT("_csrf"), TEXT("SERVER"));
-        //  TODO: why do we need server to send us pongs rather than us pinging them ?????
-        // static const FName HeartbeatHeader(TEXT("heart-beat"));
-        // StompHeader.Add(HeartbeatHeader, TEXT("0,15000"));
+            StompClient->OnConnected().AddUObject(this, &UAdhocGameModeComponent::OnStompConnected);
+            StompClient->OnConnectionError().AddUObject(this, &UAdhocGameModeComponent::OnStompConnectionError);
+            StompClient->OnError().AddUObject(this, &UAdhocGameModeComponent::OnStompError);
+            StompClient->OnClosed().AddUObject(this, &UAdhocGameModeComponent::OnStompClosed);
+
+            // FStompHeader StompHeader;
+            // StompHeader.Add(TEXT("X-CSRF-TOKEN"), TEXT("SERVER"));
+            // StompHeader.Add(TEXT("_csrf"), TEXT("SERVER"));
+            //  TODO: why do we need server to send us pongs rather than us pinging them ?????
+            // static const FName HeartbeatHeader(TEXT("heart-beat"));
+            // StompHeader.Add(HeartbeatHeader, TEXT("0,15000"));
+
+            StartupTimeline.Add(TEXT("BeginPlay"), TEXT("phase"), BeginPlayStartTime, FPlatformTime::Seconds());
+            StartupTimeline.BeginPhase(TEXT("StompConnect"));
+
+            StompClient->Connect(); // StompHeader);
+        }
 
-        StompClient->Connect(); // StompHeader);
+        if (bLoadGenerator)
+        {
+            UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Load generator enabled - bots will be spawned and events triggered for load testing"));
+            NewObject<UAdhocLoadGeneratorComponent>(GameMode, TEXT("AdhocLoadGenerator"))->RegisterComponent();
+        }
     }
 #endif
 }
@@ -169,6 +310,54 @@ void UAdhocGameModeComponent::BeginPlay()
 void UAdhocGameModeComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 #if WITH_SERVER_CODE && !defined(__EMSCRIPTEN__)
+    if (ManagerClient)
+    {
+        ManagerClient->LogLatencySummary();
+        ManagerClient->CancelAll();
+    }
+
+    if (!MetricsFile.IsEmpty())
+    {
+        FAdhocMetrics::Get().SaveToFile(MetricsFile);
+    }
+    FAdhocMetrics::Get().StopHttpExport();
+    FAdhocMetrics::Get().OnCollect.Remove(MetricsCollectHandle);
+
+    TMap<FName, FAdhocEventSequencer::FStreamStats> EventStreamStats;
+    EventSequencer.GetStats(EventStreamStats);
+    for (const TPair<FName, FAdhocEventSequencer::FStreamStats>& StatsPair : EventStreamStats)
+    {
+        const FAdhocEventSequencer::FStreamStats& Stats = StatsPair.Value;
+        UE_LOG(LogAdhocGameModeComponent, Log, TEXT("Event stream %s: Received=%lld Reordered=%lld Duplicates=%lld Gaps=%lld Missed=%lld MaxReorderDepth=%d Resyncs=%lld"),
+            *StatsPair.Key.ToString(), Stats.NumReceived, Stats.NumReordered, Stats.NumDuplicates, Stats.NumGaps, Stats.NumMissed, Stats.MaxReorderDepth,
+            EventResyncCounts.FindRef(StatsPair.Key));
+    }
+
+#if WITH_ADHOC_PLUGIN_EXTRA
+    if (ActorSpawnedHandle.IsValid())
+    {
+        GetWorld()->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+        ActorSpawnedHandle.Reset();
+    }
+    if (ActorDestroyedHandle.IsValid())
+    {
+        GetWorld()->RemoveOnActorDestroyedHandler(ActorDestroyedHandle);
+        ActorDestroyedHandle.Reset();
+    }
+
+    UE_LOG(LogAdhocGameModeComponent, Log, TEXT("Emission playback: Played=%lld Late=%lld Dropped=%lld Queued=%d"),
+        EmissionPlaybackQueue.GetNumPlayed(), EmissionPlaybackQueue.GetNumLate(), EmissionPlaybackQueue.GetNumDropped(), EmissionPlaybackQueue.Num());
+    UE_LOG(LogAdhocGameModeComponent, Log, TEXT("Emission aggregation: RecentMerged=%lld RecentDropped=%lld DistantMerged=%lld DistantDropped=%lld"),
+        RecentEmissionAggregator.GetNumMerged(), RecentEmissionAggregator.GetNumDropped(), DistantEmissionAggregator.GetNumMerged(), DistantEmissionAggregator.GetNumDropped());
+    EmissionPlaybackQueue.Reset();
+#endif
+
+    if (IsReplaying())
+    {
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Replay stopped early: Replayed=%d Remaining=%d Skipped=%d"), ReplayPosition, ReplayRecords.Num() - ReplayPosition, NumReplaySkipped);
+    }
+    ManagerRecorder.Close();
+
     if (StompClient && StompClient->IsConnected())
     {
         UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Stopping Stomp connection..."));
@@ -177,6 +366,48 @@ void UAdhocGameModeComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 #endif
 }
 
+void UAdhocGameModeComponent::TickComponent(const float DeltaTime, const ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+#if WITH_SERVER_CODE && !defined(__EMSCRIPTEN__)
+    if (IsReplaying())
+    {
+        ReplayDueRecords();
+    }
+#endif
+
+#if WITH_SERVER_CODE && !defined(__EMSCRIPTEN__) && WITH_ADHOC_PLUGIN_EXTRA
+    {
+        ADHOC_SCOPE(EmissionPlayback);
+
+        EmissionPlaybackQueue.Drain(GetWorld()->GetTimeSeconds(), [this](const FAdhocBufferedEmission& BufferedEmission)
+        {
+            FAdhocEmission Emission;
+            FAdhocEmissionBuffer::ToEmission(EmissionTypes, BufferedEmission, Emission);
+            OnStaggeredEmission(MoveTemp(Emission));
+        });
+    }
+
+    if (PendingStructureJsonValues.Num() > 0)
+    {
+        ParsePendingStructures(FPlatformTime::Seconds() + StructureMaterializationBudgetMs / 1000.0);
+    }
+
+    MaterializePendingStructures();
+
+    if (EmissionPlaybackQueue.IsEmpty() && AdhocGameState->GetPendingStructures().Num() == 0 && PendingStructureJsonValues.Num() == 0 && !IsReplaying())
+    {
+        SetComponentTickEnabled(false);
+    }
+#elif WITH_SERVER_CODE && !defined(__EMSCRIPTEN__)
+    if (!IsReplaying())
+    {
+        SetComponentTickEnabled(false);
+    }
+#endif
+}
+
 void UAdhocGameModeComponent::InitFactionStates() const
 {
     // set up some default factions (will be overridden once we contact the manager server)
@@ -453,6 +684,45 @@ void UAdhocGameModeComponent::PostLogin(const APlayerController* PlayerControlle
     }
     else
     {
+        // if the manager verified this user/token recently we can admit them straight away (and revalidate in the background)
+        const FAdhocVerifiedUser* VerifiedUser = FindVerifiedUser(UserID, Token);
+        if (VerifiedUser)
+        {
+            const FAdhocFactionState* UserFaction = AdhocGameState->FindFactionByID(VerifiedUser->User.FactionID);
+            const int32 UserFactionIndex = UserFaction ? UserFaction->Index : FactionIndex;
+
+            UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("PostLogin: Admitting recently verified user: UserID=%lld UserName=%s FactionIndex=%d"),
+                VerifiedUser->User.ID, *VerifiedUser->User.Name, UserFactionIndex);
+
+            if (VerifiedUser->LastTransform.IsSet())
+            {
+                AdhocPlayerController->SetImmediateSpawnTransform(VerifiedUser->LastTransform);
+            }
+
+            ApplyUserJoin(AdhocPlayerController, VerifiedUser->User.ID, VerifiedUser->User.Name, UserFactionIndex);
+            OnUserJoinSuccess(AdhocPlayerController);
+
+            SubmitUserJoin(AdhocPlayerController, true);
+            return;
+        }
+
+        // if the token can be verified locally the user can spawn straight away with the correct faction/name
+        // (the manager join then completes in the background and will only kick the user on a definitive failure)
+        FAdhocUserState User;
+        if (bOptimisticAdmission && VerifyUserTokenLocally(Token, UserID, User))
+        {
+            const FAdhocFactionState* UserFaction = AdhocGameState->FindFactionByID(User.FactionID);
+            const int32 UserFactionIndex = UserFaction ? UserFaction->Index : FactionIndex;
+
+            UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("PostLogin: Optimistically admitting user: UserID=%lld UserName=%s FactionIndex=%d"), User.ID, *User.Name, UserFactionIndex);
+
+            ApplyUserJoin(AdhocPlayerController, User.ID, User.Name, UserFactionIndex);
+            OnUserJoinSuccess(AdhocPlayerController);
+
+            SubmitUserJoin(AdhocPlayerController, true);
+            return;
+        }
+
         // TODO: move into submit
         UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("PostLogin: Submitting human user join: UserID=%d Token=%s"), AdhocPlayerController->GetUserID(), *AdhocPlayerController->GetToken());
 
@@ -464,6 +734,16 @@ void UAdhocGameModeComponent::PostLogin(const APlayerController* PlayerControlle
 void UAdhocGameModeComponent::Logout(const AController* Controller)
 {
     UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Logout: Controller=%s"), *Controller->GetName());
+
+#if WITH_SERVER_CODE && !defined(__EMSCRIPTEN__)
+    const UAdhocPlayerControllerComponent* AdhocPlayerController = Cast<UAdhocPlayerControllerComponent>(Controller->GetComponentByClass(UAdhocPlayerControllerComponent::StaticClass()));
+    const APawn* Pawn = Controller->GetPawn();
+    if (AdhocPlayerController && Pawn)
+    {
+        const FRotator ViewRotation = Pawn->GetViewRotation();
+        UpdateVerifiedUserTransform(AdhocPlayerController, FTransform(FRotator(ViewRotation.Pitch, ViewRotation.Yaw, 0), Pawn->GetActorLocation()));
+    }
+#endif
 }
 
 void UAdhocGameModeComponent::BotJoin(const AAIController* BotController)
@@ -481,6 +761,21 @@ void UAdhocGameModeComponent::BotJoin(const AAIController* BotController)
     }
     else
     {
+        // if we have a bot user reserved we can admit the bot immediately and just let the manager know in the background
+        FAdhocUserState BotUser;
+        int32 BotFactionIndex;
+        if (TakeBotUserFromPool(AdhocBotController->GetFactionIndex(), BotUser, BotFactionIndex))
+        {
+            UE_LOG(LogAdhocGameModeComponent, VeryVerbose, TEXT("BotJoin: Using pooled bot user: UserID=%lld UserName=%s FactionIndex=%d"), BotUser.ID, *BotUser.Name, BotFactionIndex);
+
+            ApplyUserJoin(AdhocBotController, BotUser.ID, BotUser.Name, BotFactionIndex);
+            OnUserJoinSuccess(AdhocBotController);
+
+            SubmitUserJoin(AdhocBotController, true);
+            RefillBotPool();
+            return;
+        }
+
         // TODO: move into submit
         UE_LOG(LogAdhocGameModeComponent, VeryVerbose, TEXT("BotJoin: Submitting bot user join: factionIndex=%d"), AdhocBotController->GetFactionIndex());
 
@@ -492,6 +787,31 @@ void UAdhocGameModeComponent::BotJoin(const AAIController* BotController)
 void UAdhocGameModeComponent::BotLeave(const AAIController* BotController)
 {
     UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("BotLeave: BotController=%s"), *BotController->GetName());
+
+#if WITH_SERVER_CODE && !defined(__EMSCRIPTEN__)
+    const UAdhocAIControllerComponent* AdhocBotController = Cast<UAdhocAIControllerComponent>(BotController->GetComponentByClass(UAdhocAIControllerComponent::StaticClass()));
+    if (!AdhocBotController || BotPoolSize <= 0 || AdhocBotController->GetUserID() == -1
+        || AdhocBotController->GetFactionIndex() < 0 || AdhocBotController->GetFactionIndex() >= AdhocGameState->GetNumFactions())
+    {
+        return;
+    }
+
+    // return the bot user to the pool so the next bot can use it (rather than the manager having to find/register another one)
+    TArray<FAdhocUserState>& FactionBotPool = BotPool.FindOrAdd(AdhocBotController->GetFactionIndex());
+    if (FactionBotPool.Num() >= BotPoolSize * 2)
+    {
+        return;
+    }
+
+    FAdhocUserState BotUser;
+    BotUser.ID = AdhocBotController->GetUserID();
+    BotUser.Name = AdhocBotController->GetFriendlyName();
+    BotUser.FactionID = AdhocGameState->GetFaction(AdhocBotController->GetFactionIndex()).ID;
+    FactionBotPool.Add(BotUser);
+
+    UE_LOG(LogAdhocGameModeComponent, VeryVerbose, TEXT("BotLeave: Returned bot user to pool: UserID=%lld FactionIndex=%d PoolSize=%d"),
+        BotUser.ID, AdhocBotController->GetFactionIndex(), FactionBotPool.Num());
+#endif
 }
 
 void UAdhocGameModeComponent::ObjectiveTaken(FAdhocObjectiveState& OutObjective, FAdhocFactionState& Faction) const
@@ -510,8 +830,8 @@ void UAdhocGameModeComponent::ObjectiveTaken(FAdhocObjectiveState& OutObjective,
         Writer->WriteObjectEnd();
         Writer->Close();
 
-        UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Sending: %s"), *JsonString);
-        StompClient->Send("/app/ObjectiveTaken", JsonString);
+        ADHOC_LOG_BODY(LogAdhocGameModeComponent, Verbose, JsonString, TEXT("Sending:"));
+        SendStompMessage(TEXT("/app/ObjectiveTaken"), JsonString);
     }
     else
 #endif
@@ -522,6 +842,8 @@ void UAdhocGameModeComponent::ObjectiveTaken(FAdhocObjectiveState& OutObjective,
 
 void UAdhocGameModeComponent::OnObjectiveTakenEvent(FAdhocObjectiveState& OutObjective, FAdhocFactionState& Faction) const
 {
+    ADHOC_SCOPE(OnObjectiveTakenEvent);
+
     UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("OnObjectiveTakenEvent: OutObjective.ID=%d Faction.ID=%d"), OutObjective.ID, Faction.ID);
 
     OutObjective.FactionID = Faction.ID;
@@ -581,8 +903,8 @@ void UAdhocGameModeComponent::UserDefeat(AController* Controller, AController* D
         Writer->WriteObjectEnd();
         Writer->Close();
 
-        UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Sending: %s"), *JsonString);
-        StompClient->Send("/app/ServerUserDefeat", JsonString);
+        ADHOC_LOG_BODY(LogAdhocGameModeComponent, Verbose, JsonString, TEXT("Sending:"));
+        SendStompMessage(TEXT("/app/ServerUserDefeat"), JsonString);
 
         // TODO: trigger via event?
         OnUserDefeatEvent(Controller, DefeatedController);
@@ -674,12 +996,27 @@ void UAdhocGameModeComponent::OnStompConnected(const FString& ProtocolVersion, c
 {
     UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("OnStompConnected: ProtocolVersion=%s SessionId=%s ServerString=%s"), *ProtocolVersion, *SessionId, *ServerString);
 
-    static FStompSubscriptionEvent StompSubscriptionEvent;
-    static FStompRequestCompleted StompRequestCompleted;
-    StompSubscriptionEvent.BindUObject(this, &UAdhocGameModeComponent::OnStompSubscriptionEvent);
-    StompRequestCompleted.BindUObject(this, &UAdhocGameModeComponent::OnStompRequestCompleted);
+    StartupTimeline.EndPhase(TEXT("StompConnect"));
+
+    if (bScopedEventTopics)
+    {
+        // only events for the world as a whole, our region, this server and our areas (area topics follow our active areas)
+        SubscribeEventTopic(TEXT("/topic/events/world"));
+        SubscribeEventTopic(FString::Printf(TEXT("/topic/events/regions/%d"), AdhocGameState->GetRegionID()));
+        SubscribeEventTopic(FString::Printf(TEXT("/topic/events/servers/%d"), AdhocGameState->GetServerID()));
+        UpdateAreaEventSubscriptions();
+    }
+    else
+    {
+        SubscribeEventTopic(TEXT("/topic/events"));
+    }
 
-    StompClient->Subscribe("/topic/events", StompSubscriptionEvent, StompRequestCompleted);
+    GetWorld()->GetTimerManager().SetTimer(TimerHandle_EventSequencer, this, &UAdhocGameModeComponent::OnTimer_EventSequencer, 0.25f, true);
+
+    if (bOptimisticAdmission)
+    {
+        RetrieveUserTokenKey();
+    }
 
     RetrieveFactions();
     RetrieveServers();
@@ -687,6 +1024,66 @@ void UAdhocGameModeComponent::OnStompConnected(const FString& ProtocolVersion, c
     SubmitAreas();
 }
 
+FString UAdhocGameModeComponent::SubscribeEventTopic(const FString& Destination)
+{
+    FStompSubscriptionEvent StompSubscriptionEvent;
+    FStompRequestCompleted StompRequestCompleted;
+    StompSubscriptionEvent.BindUObject(this, &UAdhocGameModeComponent::OnStompSubscriptionEvent);
+    StompRequestCompleted.BindUObject(this, &UAdhocGameModeComponent::OnStompRequestCompleted);
+
+    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Subscribing to %s"), *Destination);
+
+    return StompClient->Subscribe(Destination, StompSubscriptionEvent, StompRequestCompleted);
+}
+
+void UAdhocGameModeComponent::UpdateAreaEventSubscriptions()
+{
+    if (!bScopedEventTopics || !StompClient || !StompClient->IsConnected())
+    {
+        return;
+    }
+
+    // nearby areas are included so we still get emissions close enough to our areas to be relevant
+    TArray<int32> AreaIndexes;
+    AdhocGameState->FindAreaIndexesNearActiveAreas(EmissionRelevancyMargin, AreaIndexes);
+
+    for (auto It = AreaEventSubscriptions.CreateIterator(); It; ++It)
+    {
+        if (!AreaIndexes.Contains(It.Key()))
+        {
+            UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Unsubscribing from area %d events"), It.Key());
+            StompClient->Unsubscribe(It.Value());
+
+            // otherwise the first event after subscribing again would look like a gap
+            const FString StreamSuffix = TEXT("@") + GetAreaEventTopic(It.Key());
+            TMap<FName, FAdhocEventSequencer::FStreamStats> EventStreamStats;
+            EventSequencer.GetStats(EventStreamStats);
+            for (const auto& EventStream : EventStreamStats)
+            {
+                if (EventStream.Key.ToString().EndsWith(StreamSuffix))
+                {
+                    EventSequencer.Remove(EventStream.Key);
+                }
+            }
+
+            It.RemoveCurrent();
+        }
+    }
+
+    for (const int32 AreaIndex : AreaIndexes)
+    {
+        if (!AreaEventSubscriptions.Contains(AreaIndex))
+        {
+            AreaEventSubscriptions.Add(AreaIndex, SubscribeEventTopic(GetAreaEventTopic(AreaIndex)));
+        }
+    }
+}
+
+FString UAdhocGameModeComponent::GetAreaEventTopic(const int32 AreaIndex) const
+{
+    return FString::Printf(TEXT("/topic/events/regions/%d/areas/%d"), AdhocGameState->GetRegionID(), AreaIndex);
+}
+
 void UAdhocGameModeComponent::OnStompClosed(const FString& Reason) const
 {
     UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("OnStompClosed: Reason=%s"), *Reason);
@@ -731,17 +1128,179 @@ void UAdhocGameModeComponent::OnStompRequestCompleted(bool bSuccess, const FStri
     }
 }
 
+void UAdhocGameModeComponent::SendStompMessage(const TCHAR* Destination, const FString& Body) const
+{
+    const FString DestinationLabel = FAdhocMetrics::Label(TEXT("destination"), Destination);
+    FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_stomp_messages_sent_total"), DestinationLabel);
+    FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_stomp_bytes_sent_total"), DestinationLabel, FTCHARToUTF8(*Body).Length());
+
+    // no connection when replaying a recording
+    if (StompClient)
+    {
+        StompClient->Send(Destination, Body);
+    }
+}
+
 void UAdhocGameModeComponent::OnStompSubscriptionEvent(const IStompMessage& Message)
 {
-    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("OnStompSubscriptionEvent: %s"), *Message.GetBodyAsString());
+    ADHOC_SCOPE(OnStompSubscriptionEvent);
+
+    // convert the body once - the same string is used for recording, logging and parsing
+    const FString Body = Message.GetBodyAsString();
+
+    if (ManagerRecorder.IsOpen())
+    {
+        ManagerRecorder.RecordStompEvent(Message.GetDestination(), Body);
+    }
+
+    HandleStompEvent(Message.GetDestination(), Body, Message.GetRawBody().Num());
+}
+
+void UAdhocGameModeComponent::HandleStompEvent(const FString& Destination, const FString& Body, const int32 NumBytes)
+{
+    const double ParseStartTime = FPlatformTime::Seconds();
+
+    ADHOC_LOG_BODY(LogAdhocGameModeComponent, Verbose, Body, TEXT("OnStompSubscriptionEvent:"));
 
-    const auto& Reader = TJsonReaderFactory<>::Create(Message.GetBodyAsString());
+    const auto& Reader = TJsonReaderFactory<>::CreateFromView(Body);
     TSharedPtr<FJsonObject> JsonObject;
     if (!FJsonSerializer::Deserialize(Reader, JsonObject))
     {
-        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to deserialize Stomp event: %s"), *Message.GetBodyAsString());
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to deserialize Stomp event: %s"), *FAdhocBodyLog::Truncate(Body));
+        FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_json_deserialize_failures_total"), FAdhocMetrics::Label(TEXT("source"), TEXT("stomp")));
+        return;
+    }
+
+    const FString EventTypeLabel = FAdhocMetrics::Label(TEXT("event_type"), JsonObject->GetStringField("eventType"));
+    FAdhocMetrics::Get().ObserveHistogram(TEXT("adhoc_stomp_parse_seconds"), EventTypeLabel, (FPlatformTime::Seconds() - ParseStartTime) * 1000);
+    FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_stomp_messages_received_total"), EventTypeLabel);
+    FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_stomp_bytes_received_total"), EventTypeLabel, NumBytes);
+
+    // events carrying a sequence number are applied in order per stream (with gaps triggering a resync of just that stream)
+    const FName Stream = GetEventStream(JsonObject->GetStringField("eventType"));
+    int64 Sequence;
+    if (!Stream.IsNone() && JsonObject->TryGetNumberField(TEXT("sequence"), Sequence))
+    {
+        // each scoped topic numbers its streams independently (we do not see the other topics' events so they would look like gaps)
+        const FName SequenceStream = bScopedEventTopics ? FName(Stream.ToString() + TEXT("@") + Destination) : Stream;
+
+        EventSequencer.Receive(SequenceStream, Sequence, JsonObject, FPlatformTime::Seconds(),
+            [this](const TSharedPtr<FJsonObject>& Event) { ApplyStompEvent(Event); },
+            [this](const FName GapStream) { OnEventStreamGap(GapStream); });
+        return;
+    }
+
+    ApplyStompEvent(JsonObject);
+}
+
+FName UAdhocGameModeComponent::GetEventStream(const FString& EventType)
+{
+    // NOTE: emissions are deliberately not sequenced (holding them back would only make them late and a lost one does not need a resync)
+    if (EventType.Equals(TEXT("ObjectiveTaken")))
+    {
+        return TEXT("objectives");
+    }
+    if (EventType.Equals(TEXT("ServerUpdated")))
+    {
+        return TEXT("servers");
+    }
+    if (EventType.Equals(TEXT("WorldUpdated")))
+    {
+        return TEXT("world");
+    }
+    if (EventType.Equals(TEXT("StructureCreated")))
+    {
+        return TEXT("structures");
+    }
+    return NAME_None;
+}
+
+void UAdhocGameModeComponent::SeedEventStream(const FName Stream, const int64 Version)
+{
+    // events in the unscoped topic are numbered by the version of the change, so anything up to the version we have already seen is covered
+    // (scoped topics number their streams independently so they just start from their first event)
+    if (bScopedEventTopics || Version < 0)
+    {
         return;
     }
+
+    EventSequencer.Seed(Stream, Version + 1, [this](const TSharedPtr<FJsonObject>& Event) { ApplyStompEvent(Event); });
+}
+
+void UAdhocGameModeComponent::OnEventStreamGap(const FName SequenceStream)
+{
+    // strip any topic qualifier (the resync is for the entity type regardless of which topic it came from)
+    FString StreamString = SequenceStream.ToString();
+    int32 QualifierIndex;
+    if (StreamString.FindChar(TEXT('@'), QualifierIndex))
+    {
+        StreamString.LeftInline(QualifierIndex);
+    }
+    const FName Stream(StreamString);
+
+    UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Gap detected in event stream %s - will resync"), *Stream.ToString());
+
+    PendingEventResyncs.Add(Stream);
+
+    const double* LastResyncTime = EventResyncTimes.Find(Stream);
+    if (!LastResyncTime || FPlatformTime::Seconds() - *LastResyncTime >= EventResyncMinInterval)
+    {
+        ResyncEventStream(Stream);
+    }
+}
+
+void UAdhocGameModeComponent::ResyncEventStream(const FName Stream)
+{
+    PendingEventResyncs.Remove(Stream);
+    EventResyncTimes.Add(Stream, FPlatformTime::Seconds());
+    EventResyncCounts.FindOrAdd(Stream)++;
+
+    if (Stream == TEXT("servers"))
+    {
+        RetrieveServers(false, true);
+    }
+    else if (Stream == TEXT("objectives"))
+    {
+        RetrieveObjectives();
+    }
+    else
+    {
+        // world updates carry the complete world state (so the next one catches us up) and structures have no changed-since query
+        UE_LOG(LogAdhocGameModeComponent, Log, TEXT("No resync available for event stream %s"), *Stream.ToString());
+    }
+}
+
+void UAdhocGameModeComponent::OnTimer_EventSequencer()
+{
+    ADHOC_SCOPE(OnTimer_EventSequencer);
+
+    const FAdhocMetrics::FScopedTimer MetricsTimer(TEXT("adhoc_timer_seconds"), FAdhocMetrics::Label(TEXT("timer"), TEXT("EventSequencer")));
+
+    EventSequencer.Flush(FPlatformTime::Seconds(),
+        [this](const TSharedPtr<FJsonObject>& Event) { ApplyStompEvent(Event); },
+        [this](const FName GapStream) { OnEventStreamGap(GapStream); });
+
+    const double Now = FPlatformTime::Seconds();
+    for (const FName Stream : PendingEventResyncs.Array())
+    {
+        if (Now - EventResyncTimes.FindRef(Stream) >= EventResyncMinInterval)
+        {
+            ResyncEventStream(Stream);
+        }
+    }
+}
+
+static FString EventToString(const TSharedPtr<FJsonObject>& JsonObject)
+{
+    FString Body;
+    FJsonSerializer::Serialize(JsonObject.ToSharedRef(), TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Body));
+    return Body;
+}
+
+void UAdhocGameModeComponent::ApplyStompEvent(const TSharedPtr<FJsonObject>& JsonObject)
+{
+    ADHOC_SCOPE(ApplyStompEvent);
+
     const FString EventType = JsonObject->GetStringField("eventType");
     // UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("OnStompSubscriptionEvent: eventType=%s"), *eventType);
 
@@ -760,6 +1319,18 @@ void UAdhocGameModeComponent::OnStompSubscriptionEvent(const IStompMessage& Mess
         }
 
         OnObjectiveTakenEvent(*Objective, *Faction);
+
+        // so a later resync only asks for what changed after this
+        int64 EventVersion;
+        if (JsonObject->TryGetNumberField(TEXT("version"), EventVersion))
+        {
+            Objective->Version = FMath::Max(Objective->Version, EventVersion);
+            // (stays -1 until we have a full set)
+            if (ObjectivesVersion >= 0)
+            {
+                ObjectivesVersion = FMath::Max(ObjectivesVersion, EventVersion);
+            }
+        }
     }
     else if (EventType.Equals(TEXT("ServerUpdated")))
     {
@@ -791,14 +1362,25 @@ void UAdhocGameModeComponent::OnStompSubscriptionEvent(const IStompMessage& Mess
         }
 
         OnServerUpdatedEvent(EventServerID, EventRegionID, EventEnabled, EventActive, EventPrivateIP, EventPublicIP, EventServerPublicWebSocketPort, EventAreaIDs, EventAreaIndexes);
-    }
+
+        int64 EventVersion;
+        FAdhocServerState* Server = AdhocGameState->FindServerByID(EventServerID);
+        if (Server && JsonObject->TryGetNumberField(TEXT("version"), EventVersion))
+        {
+            Server->Version = FMath::Max(Server->Version, EventVersion);
+            if (ServersVersion >= 0)
+            {
+                ServersVersion = FMath::Max(ServersVersion, EventVersion);
+            }
+        }
+    }
     else if (EventType.Equals(TEXT("WorldUpdated")))
     {
         const TSharedPtr<FJsonObject>* WorldJsonObjectPtr;
 
         if (!JsonObject->TryGetObjectField(TEXT("world"), WorldJsonObjectPtr))
         {
-            UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Invalid WorldUpdated event: Body=%s"), *Message.GetBodyAsString());
+            UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Invalid WorldUpdated event: Body=%s"), *EventToString(JsonObject));
             return;
         }
 
@@ -822,13 +1404,54 @@ void UAdhocGameModeComponent::OnStompSubscriptionEvent(const IStompMessage& Mess
 
         if (!JsonObject->TryGetObjectField(TEXT("structure"), StructureJsonObjectPtr))
         {
-            UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Invalid StructureUpdated event: Body=%s"), *Message.GetBodyAsString());
+            UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Invalid StructureUpdated event: Body=%s"), *EventToString(JsonObject));
             return;
         }
 
         ExtractStructureFromJsonObject(*StructureJsonObjectPtr, Structure);
 
-        OnStructureCreatedEvent(Structure);
+        EnqueueStructure(Structure);
+    }
+    else if (EventType.Equals(TEXT("Emissions")) && FAdhocEmissionBuffer::IsBufferEventJson(JsonObject))
+    {
+        if (!ReceivedEmissionBuffer.ReadEventJson(JsonObject, EmissionTypes))
+        {
+            UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Invalid Emissions event: Body=%s"), *EventToString(JsonObject));
+            return;
+        }
+
+        RelevantEmissionBuffer.Reset();
+        RelevantEmissionBuffer.RegionID = AdhocGameState->GetRegionID();
+
+        for (int32 Index = 0; Index < ReceivedEmissionBuffer.Num(); Index++)
+        {
+            FAdhocBufferedEmission Emission = ReceivedEmissionBuffer.Get(Index);
+            Emission.RegionID = GetEmissionRegionID(Emission.RegionID, Emission.ServerID);
+
+            if (!IsEmissionRelevant(Emission.Location, Emission.RegionID, Emission.AreaIndex))
+            {
+                continue;
+            }
+
+            // emissions outside our areas only need a coarse (aggregated) representation
+            if (IsEmissionDistant(Emission.Location, Emission.RegionID, Emission.AreaIndex))
+            {
+                DistantEmissionAggregator.Add(DistantEmissionBuffer, EmissionTypes, Emission.ServerID, Emission.TypeID, Emission.Location, Emission.Rotation, Emission.Timestamp,
+                    Emission.AreaIndex, Emission.Count, Emission.Radius);
+                continue;
+            }
+
+            RelevantEmissionBuffer.Add(Emission);
+        }
+
+        AppendDistantEmissions();
+
+        UE_LOG(LogAdhocGameModeComponent, VeryVerbose, TEXT("Emissions event: Received=%d Relevant=%d"), ReceivedEmissionBuffer.Num(), RelevantEmissionBuffer.Num());
+
+        if (RelevantEmissionBuffer.Num() > 0)
+        {
+            ScheduleEmissions(ReceivedEmissionBuffer.BaseTimestamp, RelevantEmissionBuffer);
+        }
     }
     else if (EventType.Equals(TEXT("Emissions")))
     {
@@ -838,294 +1461,1227 @@ void UAdhocGameModeComponent::OnStompSubscriptionEvent(const IStompMessage& Mess
 
         TArray<TSharedPtr<FJsonValue>> EmissionJsonValues = JsonObject->GetArrayField("emissions");
 
-        TArray<FAdhocEmission> Emissions;
-        Emissions.Reserve(EmissionJsonValues.Num());
+        RelevantEmissionBuffer.Reset();
+        RelevantEmissionBuffer.RegionID = AdhocGameState->GetRegionID();
 
         for (auto& EmissionJsonValue : EmissionJsonValues)
         {
+            const TSharedPtr<FJsonObject>& EmissionJsonObject = EmissionJsonValue->AsObject();
+
             FAdhocEmission Emission;
-            ExtractEmissionFromJsonObject(EmissionJsonValue->AsObject(), Emission);
-            Emissions.Emplace(Emission);
+            ExtractEmissionFromJsonObject(EmissionJsonObject, Emission);
+            EmissionJsonObject->TryGetNumberField(TEXT("regionId"), Emission.RegionID);
+            EmissionJsonObject->TryGetNumberField(TEXT("areaIndex"), Emission.AreaIndex);
+            EmissionJsonObject->TryGetNumberField(TEXT("count"), Emission.Count);
+            EmissionJsonObject->TryGetNumberField(TEXT("radius"), Emission.Radius);
+
+            Emission.RegionID = GetEmissionRegionID(Emission.RegionID, Emission.ServerID);
+
+            // drop irrelevant emissions here before any timers / actors are created for them
+            if (!IsEmissionRelevant(Emission.Location, Emission.RegionID, Emission.AreaIndex))
+            {
+                continue;
+            }
+
+            const uint16 TypeID = EmissionTypes.FindOrAdd(FName(*Emission.Category), FName(*Emission.Type));
+            if (TypeID == FAdhocEmissionTypeTable::InvalidTypeID)
+            {
+                continue;
+            }
+
+            if (IsEmissionDistant(Emission.Location, Emission.RegionID, Emission.AreaIndex))
+            {
+                DistantEmissionAggregator.Add(DistantEmissionBuffer, EmissionTypes, Emission.ServerID, TypeID, Emission.Location, Emission.Rotation, Emission.Timestamp,
+                    Emission.AreaIndex, Emission.Count, Emission.Radius);
+                continue;
+            }
+
+            RelevantEmissionBuffer.Add(Emission.ServerID, TypeID, Emission.Location, Emission.Rotation, Emission.Timestamp, Emission.AreaIndex, Emission.Count, Emission.Radius);
         }
 
-        OnEmissionsEvent(BaseTimestamp, Emissions);
+        AppendDistantEmissions();
+
+        UE_LOG(LogAdhocGameModeComponent, VeryVerbose, TEXT("Emissions event: Received=%d Relevant=%d"), EmissionJsonValues.Num(), RelevantEmissionBuffer.Num());
+
+        if (RelevantEmissionBuffer.Num() > 0)
+        {
+            ScheduleEmissions(BaseTimestamp, RelevantEmissionBuffer);
+        }
     }
 #endif
 }
 
-void UAdhocGameModeComponent::RetrieveFactions()
+#if WITH_ADHOC_PLUGIN_EXTRA
+void UAdhocGameModeComponent::TagEmissionArea(FAdhocEmission& Emission) const
 {
-    const auto& Request = Http->CreateRequest();
-    Request->OnProcessRequestComplete().BindUObject(this, &UAdhocGameModeComponent::OnFactionsResponse);
-    const FString URL = FString::Printf(TEXT("http://%s:80/adhoc_api/servers/%d/factions"), *ManagerHost, AdhocGameState->GetServerID());
-    Request->SetURL(URL);
-    Request->SetVerb("GET");
-    Request->SetHeader(BasicAuthHeaderName, BasicAuthHeaderValue);
-
-    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("GET %s"), *URL);
-    Request->ProcessRequest();
+    Emission.RegionID = AdhocGameState->GetRegionID();
+    Emission.AreaIndex = AdhocGameState->FindAreaIndexByLocation(Emission.Location);
 }
 
-void UAdhocGameModeComponent::OnFactionsResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful) const
+void UAdhocGameModeComponent::OnTimer_SendRecentEmissions()
 {
-    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Factions response: ResponseCode=%d Content=%s"), Response->GetResponseCode(), *Response->GetContentAsString());
+    ADHOC_SCOPE(OnTimer_SendRecentEmissions);
+
+    const FAdhocMetrics::FScopedTimer MetricsTimer(TEXT("adhoc_timer_seconds"), FAdhocMetrics::Label(TEXT("timer"), TEXT("RecentEmissions")));
 
-    if (!bWasSuccessful || Response->GetResponseCode() != 200)
+    // emissions added via AddEmission(const FAdhocEmission&) are not tagged when added
+    for (FAdhocEmission& Emission : RecentEmissions)
     {
-        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Factions response failure: ResponseCode=%d Content=%s"), Response->GetResponseCode(), *Response->GetContentAsString());
-        ShutdownIfNotInEditor();
+        if (Emission.AreaIndex == -1)
+        {
+            TagEmissionArea(Emission);
+        }
+    }
+
+    if (!bEmissionBufferFormat)
+    {
+        OnTimer_RecentEmissions();
         return;
     }
 
-    const auto& Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
-    TArray<TSharedPtr<FJsonValue>> JsonValues;
-    if (!FJsonSerializer::Deserialize(Reader, JsonValues))
+    for (const FAdhocEmission& Emission : RecentEmissions)
     {
-        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to deserialize factions response: Content=%s"), *Response->GetContentAsString());
-        ShutdownIfNotInEditor();
+        const uint16 TypeID = EmissionTypes.FindOrAdd(FName(*Emission.Category), FName(*Emission.Type));
+        if (TypeID != FAdhocEmissionTypeTable::InvalidTypeID)
+        {
+            RecentEmissionBuffer.RegionID = Emission.RegionID;
+            RecentEmissionAggregator.Add(RecentEmissionBuffer, EmissionTypes, Emission.ServerID, TypeID, Emission.Location, Emission.Rotation, Emission.Timestamp,
+                Emission.AreaIndex, Emission.Count, Emission.Radius);
+        }
+    }
+    RecentEmissions.Reset();
+
+    SendRecentEmissionBuffer();
+}
+
+int32 UAdhocGameModeComponent::GetEmissionRegionID(const int32 RegionID, const int64 ServerID) const
+{
+    if (RegionID != -1)
+    {
+        return RegionID;
+    }
+
+    const FAdhocServerState* Server = AdhocGameState->FindServerByID(ServerID);
+    return Server ? Server->RegionID : -1;
+}
+
+bool UAdhocGameModeComponent::IsEmissionRelevant(const FVector& Location, const int32 RegionID, const int32 AreaIndex) const
+{
+    if (EmissionRelevancyMargin < 0)
+    {
+        return true;
+    }
+
+    // area indexes and locations are only comparable within a region
+    if (RegionID != AdhocGameState->GetRegionID())
+    {
+        return false;
+    }
+
+    if (AreaIndex != -1 && AdhocGameState->GetActiveAreaIndexes().Contains(AreaIndex))
+    {
+        return true;
+    }
+
+    // emissions in other areas may still be close enough to one of ours to be seen/heard
+    return AdhocGameState->IsLocationNearActiveAreas(Location, EmissionRelevancyMargin);
+}
+
+bool UAdhocGameModeComponent::IsEmissionDistant(const FVector& Location, const int32 RegionID, const int32 AreaIndex) const
+{
+    // only possible to get here from another region if every emission is relevant (negative margin)
+    if (RegionID != AdhocGameState->GetRegionID())
+    {
+        return true;
+    }
+
+    if (AreaIndex != -1 && AdhocGameState->GetActiveAreaIndexes().Contains(AreaIndex))
+    {
+        return false;
+    }
+
+    return !AdhocGameState->IsLocationNearActiveAreas(Location, 0);
+}
+
+void UAdhocGameModeComponent::AppendDistantEmissions()
+{
+    for (int32 Index = 0; Index < DistantEmissionBuffer.Num(); Index++)
+    {
+        RelevantEmissionBuffer.Add(DistantEmissionBuffer.Get(Index));
+    }
+
+    DistantEmissionBuffer.Reset();
+    DistantEmissionAggregator.Reset();
+}
+
+void UAdhocGameModeComponent::ScheduleEmissions(const FDateTime& BaseTimestamp, const FAdhocEmissionBuffer& Emissions)
+{
+    ADHOC_SCOPE(ScheduleEmissions);
+
+    if (!bEmissionPlaybackQueue)
+    {
+        TArray<FAdhocEmission> PlaybackEmissions;
+        PlaybackEmissions.SetNum(Emissions.Num());
+        for (int32 Index = 0; Index < Emissions.Num(); Index++)
+        {
+            Emissions.ToEmission(EmissionTypes, Index, PlaybackEmissions[Index]);
+        }
+
+        OnEmissionsEvent(BaseTimestamp, PlaybackEmissions);
         return;
     }
 
-    TArray<FAdhocFactionState> Factions;
-    Factions.SetNum(JsonValues.Num());
+    const double Now = GetWorld()->GetTimeSeconds();
+    for (int32 Index = 0; Index < Emissions.Num(); Index++)
+    {
+        const FAdhocBufferedEmission Emission = Emissions.Get(Index);
+
+        // keep the original spacing (but never wait more than a few seconds whatever the timestamps say)
+        const double Delay = FMath::Clamp((Emission.Timestamp - BaseTimestamp).GetTotalSeconds(), 0.0, 5.0);
+        EmissionPlaybackQueue.Enqueue(Now + Delay, Emission);
+    }
 
-    for (int i = 0; i < JsonValues.Num(); i++)
+    if (!EmissionPlaybackQueue.IsEmpty())
     {
-        const TSharedPtr<FJsonObject> JsonObject = JsonValues[i]->AsObject();
-        Factions[i].ID = JsonObject->GetIntegerField("id");
-        Factions[i].Index = JsonObject->GetIntegerField("index");
-        Factions[i].Name = JsonObject->GetStringField("name");
-        Factions[i].Color = FColor::FromHex(JsonObject->GetStringField("color"));
-        Factions[i].Score = JsonObject->GetIntegerField("score");
+        SetComponentTickEnabled(true);
     }
+}
 
-    AdhocGameState->SetFactions(Factions);
+void UAdhocGameModeComponent::AddEmission(const FName Category, const FName Type, const FVector& Location, const FRotator& Rotation)
+{
+    if (!bEmissionBufferFormat)
+    {
+        FAdhocEmission Emission;
+        Emission.ServerID = AdhocGameState->GetServerID();
+        Emission.Category = Category.ToString();
+        Emission.Type = Type.ToString();
+        Emission.Location = Location;
+        Emission.Rotation = Rotation;
+        Emission.Timestamp = FDateTime::UtcNow();
+        TagEmissionArea(Emission);
+
+        AddEmission(Emission);
+        return;
+    }
+
+    const uint16 TypeID = EmissionTypes.FindOrAdd(Category, Type);
+    if (TypeID == FAdhocEmissionTypeTable::InvalidTypeID)
+    {
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Too many emission types - ignoring emission: Category=%s Type=%s"), *Category.ToString(), *Type.ToString());
+        return;
+    }
+
+    RecentEmissionBuffer.RegionID = AdhocGameState->GetRegionID();
+    RecentEmissionAggregator.Add(RecentEmissionBuffer, EmissionTypes, AdhocGameState->GetServerID(), TypeID, Location, Rotation, FDateTime::UtcNow(),
+        AdhocGameState->FindAreaIndexByLocation(Location));
 }
 
-void UAdhocGameModeComponent::RetrieveServers()
+void UAdhocGameModeComponent::SendRecentEmissionBuffer()
 {
-    const auto& Request = Http->CreateRequest();
-    Request->OnProcessRequestComplete().BindUObject(this, &UAdhocGameModeComponent::OnServersResponse);
-    const FString URL = FString::Printf(TEXT("http://%s:80/adhoc_api/servers/%d/servers"), *ManagerHost, AdhocGameState->GetServerID());
-    Request->SetURL(URL);
-    Request->SetVerb("GET");
-    Request->SetHeader(BasicAuthHeaderName, BasicAuthHeaderValue);
+    ADHOC_SCOPE(SendRecentEmissionBuffer);
+
+    if (RecentEmissionBuffer.Num() <= 0 || !StompClient || !StompClient->IsConnected())
+    {
+        return;
+    }
+
+    FString JsonString;
+    RecentEmissionBuffer.WriteEventJson(EmissionTypes, JsonString);
+    RecentEmissionBuffer.Reset();
+    RecentEmissionAggregator.Reset();
 
-    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("GET %s"), *URL);
-    Request->ProcessRequest();
+    ADHOC_LOG_BODY(LogAdhocGameModeComponent, VeryVerbose, JsonString, TEXT("Sending:"));
+    SendStompMessage(TEXT("/app/Emissions"), JsonString);
 }
+#endif
 
-void UAdhocGameModeComponent::OnServersResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful) const
+#if WITH_ADHOC_PLUGIN_EXTRA
+void UAdhocGameModeComponent::EnqueueStructure(const FAdhocStructureState& Structure)
 {
-    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Servers response: ResponseCode=%d Content=%s"), Response->GetResponseCode(), *Response->GetContentAsString());
+    ADHOC_SCOPE(EnqueueStructure);
 
-    if (!bWasSuccessful || Response->GetResponseCode() != 200)
+    // ignore stale state (e.g. a structure page requested before a newer structure event arrived)
+    const FAdhocStructureState* ExistingStructure = AdhocGameState->GetPendingStructures().Find(Structure.UUID);
+    if (!ExistingStructure)
     {
-        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Servers response failure: ResponseCode=%d Content=%s"), Response->GetResponseCode(), *Response->GetContentAsString());
-        ShutdownIfNotInEditor();
+        ExistingStructure = AdhocGameState->GetStructures().Find(Structure.UUID);
+    }
+    if (ExistingStructure && Structure.Version >= 0 && Structure.Version < ExistingStructure->Version)
+    {
+        UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Ignoring stale structure %s: Version=%lld ExistingVersion=%lld"), *Structure.UUID.ToString(), Structure.Version,
+            ExistingStructure->Version);
         return;
     }
 
-    const auto& Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
-    TArray<TSharedPtr<FJsonValue>> JsonValues;
-    if (!FJsonSerializer::Deserialize(Reader, JsonValues))
+    if (StructureMaterializationBudgetMs <= 0)
     {
-        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to deserialize get servers response: Content=%s"), *Response->GetContentAsString());
-        ShutdownIfNotInEditor();
+        MaterializeStructure(Structure);
         return;
     }
 
-    TArray<FAdhocServerState> Servers;
-    Servers.SetNum(JsonValues.Num());
-
-    for (int i = 0; i < Servers.Num(); i++)
-    {
-        const TSharedPtr<FJsonObject> JsonObject = JsonValues[i]->AsObject();
-
-        Servers[i].ID = JsonObject->GetIntegerField("id");
-        // Servers[i].Name = JsonObject->GetStringField("name");
-        // Servers[i].HostingType = NewServer->GetStringField("hostingType");
-        // Servers[i].Status = JsonObject->GetStringField("status");
-        Servers[i].bEnabled = JsonObject->GetBoolField("enabled");
-        Servers[i].bActive = JsonObject->GetBoolField("active");
-        JsonObject->TryGetStringField("privateIP", Servers[i].PrivateIP);
-        JsonObject->TryGetStringField("publicIP", Servers[i].PublicIP);
-        JsonObject->TryGetNumberField("publicWebSocketPort", Servers[i].PublicWebSocketPort);
-        Servers[i].RegionID = JsonObject->GetIntegerField("regionId");
-        for (auto& AreaIDValue : JsonObject->GetArrayField("areaIds"))
+    // if the structure is already pending just take the latest state (it keeps its place in the order)
+    const bool bAlreadyPending = AdhocGameState->GetPendingStructures().Contains(Structure.UUID);
+    AdhocGameState->AddPendingStructure(Structure);
+    if (bAlreadyPending)
+    {
+        return;
+    }
+
+    PendingStructureOrder.HeapPush(TPair<double, FGuid>(GetStructureMaterializationPriority(Structure.Location), Structure.UUID), FPendingStructureOrderPredicate());
+
+    SetComponentTickEnabled(true);
+}
+
+double UAdhocGameModeComponent::GetStructureMaterializationPriority(const FVector& Location) const
+{
+    // nearest to any player first (structures nobody is near can wait)
+    double MinDistanceSquared = TNumericLimits<double>::Max();
+    for (const FVector& PlayerLocation : StructureMaterializationPlayerLocations)
+    {
+        MinDistanceSquared = FMath::Min(MinDistanceSquared, FVector::DistSquared(Location, PlayerLocation));
+    }
+    return MinDistanceSquared;
+}
+
+void UAdhocGameModeComponent::MaterializePendingStructures()
+{
+    ADHOC_SCOPE(MaterializePendingStructures);
+
+    const TMap<FGuid, FAdhocStructureState>& PendingStructures = AdhocGameState->GetPendingStructures();
+    if (PendingStructures.Num() == 0)
+    {
+        PendingStructureOrder.Reset();
+        return;
+    }
+
+    // players move so periodically re-evaluate the order of whatever is still pending
+    const double Now = GetWorld()->GetTimeSeconds();
+    if (Now - StructureMaterializationOrderTime >= 1.0)
+    {
+        StructureMaterializationOrderTime = Now;
+
+        StructureMaterializationPlayerLocations.Reset();
+        for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+        {
+            const APawn* Pawn = It->IsValid() ? (*It)->GetPawn() : nullptr;
+            if (Pawn)
+            {
+                StructureMaterializationPlayerLocations.Add(Pawn->GetActorLocation());
+            }
+        }
+
+        PendingStructureOrder.Reset();
+        for (const TPair<FGuid, FAdhocStructureState>& PendingStructure : PendingStructures)
         {
-            Servers[i].AreaIDs.AddUnique(AreaIDValue->AsNumber());
+            PendingStructureOrder.Emplace(GetStructureMaterializationPriority(PendingStructure.Value.Location), PendingStructure.Key);
         }
-        for (auto& AreaIndexValue : JsonObject->GetArrayField("areaIndexes"))
+        PendingStructureOrder.Heapify(FPendingStructureOrderPredicate());
+    }
+
+    // always materialize at least one per tick so we make progress whatever the budget
+    const double Deadline = FPlatformTime::Seconds() + StructureMaterializationBudgetMs / 1000.0;
+    int32 NumMaterialized = 0;
+    TPair<double, FGuid> Next;
+    while (PendingStructureOrder.Num() > 0)
+    {
+        PendingStructureOrder.HeapPop(Next, FPendingStructureOrderPredicate());
+
+        FAdhocStructureState Structure;
+        if (!AdhocGameState->RemovePendingStructure(Next.Value, Structure))
         {
-            Servers[i].AreaIndexes.AddUnique(AreaIndexValue->AsNumber());
+            continue;
         }
 
-        // if it is my server ID - what areas are assigned to this server?
-        if (AdhocGameState->GetServerID() == Servers[i].ID)
+        MaterializeStructure(Structure);
+        NumMaterialized++;
+
+        if (FPlatformTime::Seconds() >= Deadline)
         {
-            SetActiveAreas(Servers[i].RegionID, Servers[i].AreaIndexes);
+            break;
         }
     }
 
-    AdhocGameState->SetServers(Servers);
+    UE_LOG(LogAdhocGameModeComponent, VeryVerbose, TEXT("Materialized %d structures (%d still pending)"), NumMaterialized, PendingStructures.Num());
 }
 
-// PUT AREAS (the map defines the areas, and should override what is on the server, but the server will choose the IDs)
-void UAdhocGameModeComponent::SubmitAreas()
+EAdhocStructureResidency UAdhocGameModeComponent::GetStructureResidency(const FVector& Location) const
 {
-    FString JsonString;
-    const auto& Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
-
-    Writer->WriteArrayStart();
-    for (TArray<FAdhocAreaState>::TConstIterator AreaStateIter = AdhocGameState->GetAreasConstIterator(); AreaStateIter; ++AreaStateIter)
+    if (AdhocGameState->IsLocationNearActiveAreas(Location, StructureLiveMargin))
     {
-        const FAdhocAreaState& AreaState = *AreaStateIter;
-
-        Writer->WriteObjectStart();
-        Writer->WriteValue(TEXT("regionId"), AreaState.RegionID);
-        Writer->WriteValue(TEXT("index"), AreaState.Index);
-        Writer->WriteValue(TEXT("name"), AreaState.Name);
-        Writer->WriteValue(TEXT("x"), static_cast<double>(AreaState.Location.X));
-        Writer->WriteValue(TEXT("y"), static_cast<double>(-AreaState.Location.Y));
-        Writer->WriteValue(TEXT("z"), static_cast<double>(AreaState.Location.Z));
-        Writer->WriteValue(TEXT("sizeX"), static_cast<double>(AreaState.Size.X));
-        Writer->WriteValue(TEXT("sizeY"), static_cast<double>(AreaState.Size.Y));
-        Writer->WriteValue(TEXT("sizeZ"), static_cast<double>(AreaState.Size.Z));
-        // Writer->WriteNull(TEXT("serverId"));
-        Writer->WriteObjectEnd();
+        return EAdhocStructureResidency::Live;
+    }
+    if (AdhocGameState->IsLocationNearActiveAreas(Location, StructureDormantMargin))
+    {
+        return EAdhocStructureResidency::Dormant;
     }
-    Writer->WriteArrayEnd();
+    return EAdhocStructureResidency::DataOnly;
+}
 
-    Writer->Close();
+void UAdhocGameModeComponent::MaterializeStructure(const FAdhocStructureState& Structure)
+{
+    ADHOC_SCOPE(MaterializeStructure);
+
+    const EAdhocStructureResidency Residency = GetStructureResidency(Structure.Location);
 
-    const auto& Request = Http->CreateRequest();
-    Request->OnProcessRequestComplete().BindUObject(this, &UAdhocGameModeComponent::OnAreasResponse);
-    const FString URL = FString::Printf(TEXT("http://%s:80/adhoc_api/servers/%d/areas"), *ManagerHost, AdhocGameState->GetServerID());
-    Request->SetURL(URL);
-    Request->SetVerb("POST");
-    Request->SetHeader("Content-Type", "application/json");
-    Request->SetHeader(BasicAuthHeaderName, BasicAuthHeaderValue);
-    Request->SetContentAsString(JsonString);
+    if (Residency == EAdhocStructureResidency::DataOnly)
+    {
+        AdhocGameState->AddStructure(Structure);
+    }
+    else
+    {
+        MaterializingStructureUUID = Structure.UUID;
+        OnStructureCreatedEvent(Structure);
+        MaterializingStructureUUID.Invalidate();
+    }
 
-    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("PUT %s: %s"), *URL, *JsonString);
-    Request->ProcessRequest();
+    AdhocGameState->IndexStructure(Structure.UUID);
+    ApplyStructureResidency(Structure.UUID, Residency);
 }
 
-void UAdhocGameModeComponent::OnAreasResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void UAdhocGameModeComponent::ApplyStructureResidency(const FGuid& UUID, const EAdhocStructureResidency Residency)
 {
-    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Areas response: ResponseCode=%d Content=%s"), Response->GetResponseCode(), *Response->GetContentAsString());
+    StructureResidencies.Add(UUID, Residency);
 
-    if (!bWasSuccessful || Response->GetResponseCode() != 200)
+    if (Residency == EAdhocStructureResidency::DataOnly)
     {
-        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Areas response failure: ResponseCode=%d Content=%s"), Response->GetResponseCode(), *Response->GetContentAsString());
-        ShutdownIfNotInEditor();
+        if (AActor* Actor = FindStructureActor(UUID))
+        {
+            Actor->Destroy();
+        }
+        StructureActors.Remove(UUID);
         return;
     }
 
-    const auto& Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
-    TArray<TSharedPtr<FJsonValue>> JsonValues;
-    if (!FJsonSerializer::Deserialize(Reader, JsonValues))
+    AActor* Actor = FindStructureActor(UUID);
+    if (!Actor)
     {
-        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to deserialize areas response: %s"), *Response->GetContentAsString());
-        ShutdownIfNotInEditor();
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("No actor found for structure %s"), *UUID.ToString());
         return;
     }
 
-    TArray<FAdhocAreaState> Areas;
-    Areas.SetNum(JsonValues.Num());
+    const bool bLive = Residency == EAdhocStructureResidency::Live;
+    Actor->SetActorTickEnabled(bLive);
+    Actor->SetNetDormancy(bLive ? DORM_Awake : DORM_DormantAll);
+}
 
-    for (int i = 0; i < Areas.Num(); i++)
+void UAdhocGameModeComponent::UpdateStructureResidencies()
+{
+    ADHOC_SCOPE(UpdateStructureResidencies);
+
+    int32 NumLive = 0;
+    int32 NumDormant = 0;
+    int32 NumDataOnly = 0;
+
+    for (const TPair<FGuid, FAdhocStructureState>& Structure : AdhocGameState->GetStructures())
     {
-        const TSharedPtr<FJsonObject> JsonObject = JsonValues[i]->AsObject();
+        const EAdhocStructureResidency* CurrentResidency = StructureResidencies.Find(Structure.Key);
+        const EAdhocStructureResidency NewResidency = GetStructureResidency(Structure.Value.Location);
 
-        Areas[i].ID = JsonObject->GetIntegerField("id");
-        Areas[i].RegionID = JsonObject->GetIntegerField("regionId");
-        Areas[i].Index = JsonObject->GetIntegerField("index");
-        Areas[i].Name = JsonObject->GetStringField("name");
-        JsonObject->TryGetNumberField("serverId", Areas[i].ServerID);
+        NumLive += NewResidency == EAdhocStructureResidency::Live;
+        NumDormant += NewResidency == EAdhocStructureResidency::Dormant;
+        NumDataOnly += NewResidency == EAdhocStructureResidency::DataOnly;
 
-        // // any area actors in this region should be updated with IDs etc.
-        // if (Areas[i].RegionID == AdhocGameState->GetRegionID())
-        // {
-        // 	for (TActorIterator<AAreaVolume> AreaVolumeIter(GetWorld()); AreaVolumeIter; ++AreaVolumeIter)
-        // 	{
-        // 		AAreaVolume* AreaVolume = *AreaVolumeIter;
-        // 		if (AreaVolume->GetAreaIndex() == Areas[i].Index)
-        // 		{
-        // 			AreaVolume->SetAreaID(Areas[i].ID);
-        // 		}
-        // 	}
-        // }
-    }
+        if (!CurrentResidency || *CurrentResidency == NewResidency)
+        {
+            continue;
+        }
 
-    AdhocGameState->SetAreas(Areas);
+        // structures needing an actor are spawned via the (time sliced) materialization queue
+        if (*CurrentResidency == EAdhocStructureResidency::DataOnly)
+        {
+            EnqueueStructure(Structure.Value);
+            continue;
+        }
 
-    SubmitObjectives();
+        ApplyStructureResidency(Structure.Key, NewResidency);
+    }
+
+    UE_LOG(LogAdhocGameModeComponent, Log, TEXT("Structure residency: Live=%d Dormant=%d DataOnly=%d"), NumLive, NumDormant, NumDataOnly);
 }
 
-// PUT OBJECTIVES (the map defines the objectives, and should override what is on the server, but the server will choose the IDs)
-void UAdhocGameModeComponent::SubmitObjectives()
+void UAdhocGameModeComponent::AdoptBulkLoadedStructures()
 {
-    FString JsonString;
-    const auto& Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+    ADHOC_SCOPE(AdoptBulkLoadedStructures);
 
-    Writer->WriteArrayStart();
+    // the bulk load may set UUIDs after spawning, so capture its actors with a single search (rather than searching per structure)
     for (TActorIterator<AActor> ActorIter(GetWorld()); ActorIter; ++ActorIter)
     {
-        const AActor* Actor = *ActorIter;
-        UAdhocObjectiveComponent* AdhocObjective = Cast<UAdhocObjectiveComponent>(Actor->GetComponentByClass(UAdhocObjectiveComponent::StaticClass()));
-        if (!AdhocObjective)
+        const IAdhocStructureInterface* AdhocStructure = Cast<IAdhocStructureInterface>(*ActorIter);
+        if (AdhocStructure && AdhocStructure->GetUUID().IsValid())
         {
-            continue;
+            StructureActors.Add(AdhocStructure->GetUUID(), *ActorIter);
         }
+    }
 
-        // ignore objectives outside an area
-        if (AdhocObjective->GetAreaIndexSafe() == -1)
+    int32 NumAdopted = 0;
+    for (const TPair<FGuid, FAdhocStructureState>& Structure : AdhocGameState->GetStructures())
+    {
+        if (StructureResidencies.Contains(Structure.Key))
         {
-            UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Objective %d has no area!"), AdhocObjective->GetObjectiveIndex());
             continue;
         }
 
-        const FVector Location = Actor->GetActorLocation();
-        const FVector Size = FVector(1, 1, 1); // ObjectiveActor->GetActorScale() * 200; // TODO
+        AdhocGameState->IndexStructure(Structure.Key);
+        ApplyStructureResidency(Structure.Key, GetStructureResidency(Structure.Value.Location));
+        NumAdopted++;
+    }
 
-        Writer->WriteObjectStart();
-        Writer->WriteValue(TEXT("regionId"), AdhocGameState->GetRegionID());
-        Writer->WriteValue(TEXT("index"), AdhocObjective->GetObjectiveIndex());
-        Writer->WriteValue(TEXT("name"), AdhocObjective->GetFriendlyName());
-        Writer->WriteValue(TEXT("x"), static_cast<double>(Location.X));
-        Writer->WriteValue(TEXT("y"), static_cast<double>(-Location.Y));
-        Writer->WriteValue(TEXT("z"), static_cast<double>(Location.Z));
-        Writer->WriteValue(TEXT("sizeX"), static_cast<double>(Size.X));
-        Writer->WriteValue(TEXT("sizeY"), static_cast<double>(Size.Y));
-        Writer->WriteValue(TEXT("sizeZ"), static_cast<double>(Size.Z));
+    UE_LOG(LogAdhocGameModeComponent, Log, TEXT("Adopted %d bulk loaded structures"), NumAdopted);
+}
 
-        if (AdhocObjective->GetInitialFactionIndex() == -1)
+AActor* UAdhocGameModeComponent::FindStructureActor(const FGuid& UUID)
+{
+    if (const TWeakObjectPtr<AActor>* StructureActor = StructureActors.Find(UUID))
+    {
+        if (StructureActor->IsValid())
         {
-            Writer->WriteNull(TEXT("initialFactionIndex"));
+            return StructureActor->Get();
         }
-        else
+    }
+
+    return nullptr;
+}
+
+void UAdhocGameModeComponent::StartStructureSync()
+{
+    // active areas first so we can start as soon as they are loaded, then the rest of the region
+    StartupTimeline.BeginPhase(TEXT("StructureSync"));
+
+    StructureSyncAreaIndexes = AdhocGameState->GetActiveAreaIndexes();
+    NumActiveStructureSyncAreas = StructureSyncAreaIndexes.Num();
+    for (auto It = AdhocGameState->GetAreasConstIterator(); It; ++It)
+    {
+        if (It->RegionID == AdhocGameState->GetRegionID())
         {
-            Writer->WriteValue(TEXT("initialFactionIndex"), static_cast<double>(AdhocObjective->GetInitialFactionIndex()));
+            StructureSyncAreaIndexes.AddUnique(It->Index);
         }
+    }
 
-        // if (AdhocObjective->GetFactionIndex() != -1)
-        // {
-        //     Writer->WriteNull(TEXT("factionIndex"));
-        // }
-        // else
-        // {
-        //     Writer->WriteValue(TEXT("factionIndex"), static_cast<double>(AdhocObjective->GetFactionIndex()));
-        // }
+    StructureSyncAreaPosition = 0;
+    StructureSyncCursor.Reset();
+    bStructureSyncActiveAreasReceived = NumActiveStructureSyncAreas == 0;
+
+    UE_LOG(LogAdhocGameModeComponent, Log, TEXT("Starting paged structure sync: Areas=%d ActiveAreas=%d"), StructureSyncAreaIndexes.Num(), NumActiveStructureSyncAreas);
+
+    if (StructureSyncAreaIndexes.Num() == 0)
+    {
+        ServerStarted();
+        return;
+    }
+
+    RetrieveStructurePage();
+}
+
+void UAdhocGameModeComponent::RetrieveStructurePage()
+{
+    const int32 AreaIndex = StructureSyncAreaIndexes[StructureSyncAreaPosition];
+
+    FString Path = FString::Printf(TEXT("servers/%d/structures?areaIndex=%d&limit=%d"), AdhocGameState->GetServerID(), AreaIndex, StructureSyncPageSize);
+    if (!StructureSyncCursor.IsEmpty())
+    {
+        Path += FString::Printf(TEXT("&cursor=%s"), *FGenericPlatformHttp::UrlEncode(StructureSyncCursor));
+    }
+
+    bStructureSyncPageInFlight = true;
+    ManagerClient->Get(TEXT("structures"), Path, FAdhocManagerResponseDelegate::CreateUObject(this, &UAdhocGameModeComponent::OnStructurePageResponse));
+}
+
+void UAdhocGameModeComponent::RetrieveNextStructurePage()
+{
+    if (bStructureSyncPageInFlight || StructureSyncAreaPosition >= StructureSyncAreaIndexes.Num())
+    {
+        return;
+    }
+
+    // don't receive pages faster than they can be parsed - wait until less than half a page is left
+    if (PendingStructureJsonValues.Num() - PendingStructureJsonIndex > StructureSyncPageSize / 2)
+    {
+        return;
+    }
+
+    RetrieveStructurePage();
+}
+
+void UAdhocGameModeComponent::OnStructurePageResponse(const FAdhocManagerResponse& Response)
+{
+    bStructureSyncPageInFlight = false;
+
+    const bool bActiveArea = StructureSyncAreaPosition < NumActiveStructureSyncAreas;
+
+    TSharedPtr<FJsonObject> JsonObject;
+    const TArray<TSharedPtr<FJsonValue>>* StructureJsonValues = nullptr;
+    if (Response.IsOk())
+    {
+        const auto& Reader = TJsonReaderFactory<>::CreateFromView(Response.Content);
+        if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject->TryGetArrayField(TEXT("structures"), StructureJsonValues))
+        {
+            StructureJsonValues = nullptr;
+        }
+    }
+
+    if (!StructureJsonValues)
+    {
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Structure page response failure: ResponseCode=%d Content=%s"), Response.ResponseCode, *FAdhocBodyLog::Truncate(Response.Content));
+
+        // the manager client has already retried (with backoff) by now
+        // we cannot start without our own areas' structures - other areas are only needed for dormant / data only structures
+        if (bActiveArea)
+        {
+            ShutdownIfNotInEditor();
+            return;
+        }
+
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Skipping structure sync of area index %d"), StructureSyncAreaIndexes[StructureSyncAreaPosition]);
+        StructureSyncCursor.Reset();
+        StructureSyncAreaPosition++;
+        RetrieveNextStructurePage();
+        return;
+    }
+
+    // the structures stay as JSON values (with the rest of the page's DOM) until they are extracted a few at a time on tick
+    // the next page is not requested until these have mostly been parsed, so roughly one page is held at a time
+    PendingStructureJsonValues.Append(*StructureJsonValues);
+    SetComponentTickEnabled(true);
+
+    FString NextCursor;
+    if (JsonObject->TryGetStringField(TEXT("nextCursor"), NextCursor) && !NextCursor.IsEmpty())
+    {
+        StructureSyncCursor = NextCursor;
+    }
+    else
+    {
+        StructureSyncCursor.Reset();
+        StructureSyncAreaPosition++;
+
+        if (StructureSyncAreaPosition >= NumActiveStructureSyncAreas)
+        {
+            bStructureSyncActiveAreasReceived = true;
+        }
+    }
+
+    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Structure page: Structures=%d AreaPosition=%d/%d"), StructureJsonValues->Num(), StructureSyncAreaPosition,
+        StructureSyncAreaIndexes.Num());
+
+    // nothing left to parse for our active areas (e.g. they have no structures) so no need to wait for a tick
+    if (bStructureSyncActiveAreasReceived && !bServerStarted && PendingStructureJsonValues.Num() == 0)
+    {
+        ServerStarted();
+    }
+
+    // otherwise this is resumed as the pending structures are parsed
+    RetrieveNextStructurePage();
+}
+
+void UAdhocGameModeComponent::ParsePendingStructures(const double Deadline)
+{
+    ADHOC_SCOPE(ParsePendingStructures);
+
+    while (PendingStructureJsonIndex < PendingStructureJsonValues.Num())
+    {
+        const TSharedPtr<FJsonObject>* StructureJsonObject;
+        if (PendingStructureJsonValues[PendingStructureJsonIndex]->TryGetObject(StructureJsonObject))
+        {
+            FAdhocStructureState Structure;
+            ExtractStructureFromJsonObject(*StructureJsonObject, Structure);
+            EnqueueStructure(Structure);
+        }
+        PendingStructureJsonIndex++;
+
+        if (FPlatformTime::Seconds() >= Deadline)
+        {
+            break;
+        }
+    }
+
+    if (PendingStructureJsonIndex >= PendingStructureJsonValues.Num())
+    {
+        PendingStructureJsonValues.Reset();
+        PendingStructureJsonIndex = 0;
+
+        // everything received for our active areas has been parsed (and queued for materialization) so we are good to go
+        if (bStructureSyncActiveAreasReceived && !bServerStarted)
+        {
+            UE_LOG(LogAdhocGameModeComponent, Log, TEXT("Active area structures loaded - starting server (remaining areas will continue to sync)"));
+            ServerStarted();
+        }
+    }
+
+    RetrieveNextStructurePage();
+}
+
+void UAdhocGameModeComponent::OnActorSpawned(AActor* Actor)
+{
+    const IAdhocStructureInterface* AdhocStructure = Cast<IAdhocStructureInterface>(Actor);
+    if (!AdhocStructure)
+    {
+        return;
+    }
+
+    // the UUID may not be set on the actor until after it is spawned, so prefer the one being materialized
+    const FGuid UUID = MaterializingStructureUUID.IsValid() ? MaterializingStructureUUID : AdhocStructure->GetUUID();
+    if (UUID.IsValid())
+    {
+        StructureActors.Add(UUID, Actor);
+    }
+}
+
+void UAdhocGameModeComponent::OnActorDestroyed(AActor* Actor)
+{
+    const IAdhocStructureInterface* AdhocStructure = Cast<IAdhocStructureInterface>(Actor);
+    if (!AdhocStructure)
+    {
+        return;
+    }
+
+    const FGuid UUID = AdhocStructure->GetUUID();
+    const TWeakObjectPtr<AActor>* StructureActor = StructureActors.Find(UUID);
+    if (StructureActor && StructureActor->Get() == Actor)
+    {
+        StructureActors.Remove(UUID);
+    }
+}
+#endif
+
+void UAdhocGameModeComponent::RetrieveUserTokenKey()
+{
+    ManagerClient->Get(TEXT("userTokenKey"), FString::Printf(TEXT("servers/%d/userTokenKey"), AdhocGameState->GetServerID()),
+        FAdhocManagerResponseDelegate::CreateUObject(this, &UAdhocGameModeComponent::OnUserTokenKeyResponse));
+}
+
+void UAdhocGameModeComponent::OnUserTokenKeyResponse(const FAdhocManagerResponse& Response)
+{
+    // NOTE: the key is not logged
+
+    if (!bOptimisticAdmission)
+    {
+        return;
+    }
+
+    // optimistic admission is only an optimization - so if the key is not available we just carry on verifying every join with the manager
+    if (!Response.IsOk())
+    {
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("User token key response failure - optimistic admission disabled: ResponseCode=%d"),
+            Response.ResponseCode);
+        return;
+    }
+
+    const auto& Reader = TJsonReaderFactory<>::CreateFromView(Response.Content);
+    TSharedPtr<FJsonObject> JsonObject;
+    FString EncodedKey;
+    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject->TryGetStringField(TEXT("key"), EncodedKey) || !FBase64::Decode(EncodedKey, UserTokenKey))
+    {
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to process user token key response - optimistic admission disabled"));
+        UserTokenKey.Reset();
+        return;
+    }
+
+    UE_LOG(LogAdhocGameModeComponent, Log, TEXT("User token key retrieved - optimistic admission enabled"));
+}
+
+bool UAdhocGameModeComponent::VerifyUserTokenLocally(const FString& Token, const int64 UserID, FAdhocUserState& OutUser) const
+{
+    if (!bOptimisticAdmission || UserTokenKey.Num() <= 0 || UserID == -1)
+    {
+        return false;
+    }
+
+    FString EncodedPayload;
+    FString EncodedSignature;
+    if (!Token.Split(TEXT("."), &EncodedPayload, &EncodedSignature))
+    {
+        return false;
+    }
+
+    TArray<uint8> Payload;
+    TArray<uint8> Signature;
+    if (!FBase64::Decode(EncodedPayload, Payload) || !FBase64::Decode(EncodedSignature, Signature) || Signature.Num() != FSHA1::DigestSize)
+    {
+        return false;
+    }
+
+    uint8 ExpectedSignature[FSHA1::DigestSize];
+    FSHA1::HMACBuffer(UserTokenKey.GetData(), UserTokenKey.Num(), Payload.GetData(), Payload.Num(), ExpectedSignature);
+
+    // compare every byte regardless of mismatches so verification time does not depend on how much of the signature is correct
+    uint8 Difference = 0;
+    for (int32 i = 0; i < FSHA1::DigestSize; i++)
+    {
+        Difference |= ExpectedSignature[i] ^ Signature[i];
+    }
+    if (Difference != 0)
+    {
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("User token signature mismatch: UserID=%lld"), UserID);
+        return false;
+    }
+
+    const FUTF8ToTCHAR PayloadString(reinterpret_cast<const ANSICHAR*>(Payload.GetData()), Payload.Num());
+    const auto& Reader = TJsonReaderFactory<>::CreateFromView(FStringView(PayloadString.Get(), PayloadString.Length()));
+    TSharedPtr<FJsonObject> JsonObject;
+    if (!FJsonSerializer::Deserialize(Reader, JsonObject))
+    {
+        return false;
+    }
+
+    int64 TokenUserID = -1;
+    int64 TokenExpiry = 0;
+    if (!JsonObject->TryGetNumberField(TEXT("userId"), TokenUserID)
+        || !JsonObject->TryGetNumberField(TEXT("exp"), TokenExpiry)
+        || !JsonObject->TryGetNumberField(TEXT("factionId"), OutUser.FactionID)
+        || !JsonObject->TryGetStringField(TEXT("name"), OutUser.Name))
+    {
+        return false;
+    }
+
+    if (TokenUserID != UserID || TokenExpiry <= FDateTime::UtcNow().ToUnixTimestamp())
+    {
+        UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("User token not usable for optimistic admission: UserID=%lld TokenUserID=%lld TokenExpiry=%lld"), UserID, TokenUserID, TokenExpiry);
+        return false;
+    }
+
+    OutUser.ID = TokenUserID;
+    return true;
+}
+
+void UAdhocGameModeComponent::RetrieveFactions(const bool bFull)
+{
+    // once we have a full set we only need what has changed since
+    const bool bDelta = !bFull && FactionsVersion >= 0;
+    FString Path = FString::Printf(TEXT("servers/%d/factions"), AdhocGameState->GetServerID());
+    if (bDelta)
+    {
+        Path += FString::Printf(TEXT("?sinceVersion=%lld"), FactionsVersion);
+    }
+
+    ManagerClient->Get(TEXT("factions"), Path,
+        FAdhocManagerResponseDelegate::CreateUObject(this, &UAdhocGameModeComponent::OnFactionsResponse, bDelta));
+}
+
+void UAdhocGameModeComponent::OnFactionsResponse(const FAdhocManagerResponse& Response, const bool bDelta)
+{
+    ADHOC_SCOPE(OnFactionsResponse);
+
+    const FAdhocStartupTimeline::FScope TimelineScope(StartupTimeline, TEXT("Parse factions"), TEXT("json"));
+    const FAdhocMetrics::FScopedTimer MetricsTimer(TEXT("adhoc_json_seconds"), FAdhocMetrics::Label(TEXT("operation"), TEXT("parse_factions")));
+
+    ADHOC_LOG_BODY(LogAdhocGameModeComponent, Verbose, Response.Content, TEXT("Factions response: ResponseCode=%d"), Response.ResponseCode);
+
+    if (!Response.IsOk())
+    {
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Factions response failure: ResponseCode=%d Content=%s"), Response.ResponseCode, *FAdhocBodyLog::Truncate(Response.Content));
+        ShutdownIfNotStarted();
+        return;
+    }
+
+    TArray<FAdhocFactionState> Factions;
+    if (!FAdhocManagerJson::ParseFactions(Response.Content, Factions))
+    {
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to deserialize factions response: Content=%s"), *FAdhocBodyLog::Truncate(Response.Content));
+        FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_json_deserialize_failures_total"), FAdhocMetrics::Label(TEXT("source"), TEXT("factions")));
+        ShutdownIfNotStarted();
+        return;
+    }
+
+    for (const FAdhocFactionState& Faction : Factions)
+    {
+        FactionsVersion = FMath::Max(FactionsVersion, Faction.Version);
+    }
+
+    if (!bDelta)
+    {
+        AdhocGameState->SetFactions(Factions);
+        return;
+    }
+
+    // apply changes in place (adding any factions we did not know about)
+    int32 NumChanged = 0;
+    for (const FAdhocFactionState& Faction : Factions)
+    {
+        if (FAdhocFactionState* ExistingFaction = AdhocGameState->FindFactionByID(Faction.ID))
+        {
+            if (Faction.Version < 0 || Faction.Version > ExistingFaction->Version)
+            {
+                *ExistingFaction = Faction;
+                NumChanged++;
+            }
+        }
+        else
+        {
+            AdhocGameState->AddFaction(Faction);
+            NumChanged++;
+        }
+    }
+
+    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Factions delta: Received=%d Changed=%d Version=%lld"), Factions.Num(), NumChanged, FactionsVersion);
+}
+
+void UAdhocGameModeComponent::RetrieveServers(const bool bFull, const bool bEventResync)
+{
+    const bool bDelta = !bFull && ServersVersion >= 0;
+    FString Path = FString::Printf(TEXT("servers/%d/servers"), AdhocGameState->GetServerID());
+    if (bDelta)
+    {
+        Path += FString::Printf(TEXT("?sinceVersion=%lld"), ServersVersion);
+    }
+
+    ManagerClient->Get(TEXT("servers"), Path,
+        FAdhocManagerResponseDelegate::CreateUObject(this, &UAdhocGameModeComponent::OnServersResponse, bDelta, bEventResync));
+}
+
+void UAdhocGameModeComponent::OnServersResponse(const FAdhocManagerResponse& Response, const bool bDelta, const bool bEventResync)
+{
+    ADHOC_SCOPE(OnServersResponse);
+
+    const FAdhocStartupTimeline::FScope TimelineScope(StartupTimeline, TEXT("Parse servers"), TEXT("json"));
+    const FAdhocMetrics::FScopedTimer MetricsTimer(TEXT("adhoc_json_seconds"), FAdhocMetrics::Label(TEXT("operation"), TEXT("parse_servers")));
+
+    ADHOC_LOG_BODY(LogAdhocGameModeComponent, Verbose, Response.Content, TEXT("Servers response: ResponseCode=%d"), Response.ResponseCode);
+
+    if (!Response.IsOk())
+    {
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Servers response failure: ResponseCode=%d Content=%s"), Response.ResponseCode, *FAdhocBodyLog::Truncate(Response.Content));
+        OnServersFailure(bEventResync);
+        return;
+    }
+
+    TArray<FAdhocServerState> Servers;
+    if (!FAdhocManagerJson::ParseServers(Response.Content, Servers))
+    {
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to deserialize get servers response: Content=%s"), *FAdhocBodyLog::Truncate(Response.Content));
+        FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_json_deserialize_failures_total"), FAdhocMetrics::Label(TEXT("source"), TEXT("servers")));
+        OnServersFailure(bEventResync);
+        return;
+    }
+
+    for (const FAdhocServerState& Server : Servers)
+    {
+        ServersVersion = FMath::Max(ServersVersion, Server.Version);
+    }
+
+    int32 NumChanged = 0;
+    if (!bDelta)
+    {
+        AdhocGameState->SetServers(Servers);
+        NumChanged = Servers.Num();
+    }
+    else
+    {
+        // apply changes in place
+        for (int i = 0; i < Servers.Num(); i++)
+        {
+            FAdhocServerState* ExistingServer = AdhocGameState->FindOrInsertServerByID(Servers[i].ID);
+            if (Servers[i].Version >= 0 && Servers[i].Version <= ExistingServer->Version)
+            {
+                // already up to date (so no need to look at our own active areas either)
+                Servers[i].ID = -1;
+                continue;
+            }
+            *ExistingServer = Servers[i];
+            NumChanged++;
+        }
+    }
+
+    for (const FAdhocServerState& Server : Servers)
+    {
+        // if it is my server ID - what areas are assigned to this server?
+        if (Server.ID != -1 && AdhocGameState->GetServerID() == Server.ID)
+        {
+            SetActiveAreas(Server.RegionID, Server.AreaIndexes);
+        }
+    }
+
+    SeedEventStream(TEXT("servers"), ServersVersion);
+
+    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Servers response: Delta=%d Received=%d Changed=%d Version=%lld"), bDelta, Servers.Num(), NumChanged, ServersVersion);
+}
+
+void UAdhocGameModeComponent::OnServersFailure(const bool bEventResync)
+{
+    // a failed resync (even before we have started) is retried by OnTimer_EventSequencer - only failing to get the initial servers is fatal
+    if (bEventResync)
+    {
+        PendingEventResyncs.Add(TEXT("servers"));
+        return;
+    }
+
+    ShutdownIfNotStarted();
+}
+
+void UAdhocGameModeComponent::OnManagerRequestCompleted(const FName Endpoint, const FString& Request, const FAdhocManagerResponse& Response)
+{
+    if (ManagerRecorder.IsOpen())
+    {
+        ManagerRecorder.RecordResponse(Endpoint, Request, Response);
+    }
+
+    if (StartupTimeline.IsRecording())
+    {
+        const double Now = FPlatformTime::Seconds();
+        StartupTimeline.Add(Request, TEXT("http"), Now - Response.Latency, Now,
+            FString::Printf(TEXT("endpoint=%s code=%d attempts=%d bytes=%d"), *Endpoint.ToString(), Response.ResponseCode, Response.Attempts, Response.Content.Len()));
+    }
+}
+
+void UAdhocGameModeComponent::StartReplay()
+{
+    if (!FAdhocManagerRecorder::Load(ManagerReplayFile, ReplayRecords) || ReplayRecords.Num() <= 0)
+    {
+        UE_LOG(LogAdhocGameModeComponent, Error, TEXT("Nothing to replay from %s"), *ManagerReplayFile);
+        ShutdownIfNotInEditor();
+        return;
+    }
+
+    UE_LOG(LogAdhocGameModeComponent, Log, TEXT("Replaying %d manager messages from %s: ManagerReplaySpeed=%f"), ReplayRecords.Num(), *ManagerReplayFile, ManagerReplaySpeed);
+
+    // normally started once stomp connects
+    GetWorld()->GetTimerManager().SetTimer(TimerHandle_EventSequencer, this, &UAdhocGameModeComponent::OnTimer_EventSequencer, 0.25f, true);
+
+    ReplayPosition = 0;
+    NumReplaySkipped = 0;
+    ReplayStartTime = FPlatformTime::Seconds();
+
+    SetComponentTickEnabled(true);
+}
+
+void UAdhocGameModeComponent::ReplayDueRecords()
+{
+    ADHOC_SCOPE(ReplayDueRecords);
+
+    const FDateTime FirstTimestamp = ReplayRecords[0].Timestamp;
+    const double ReplaySeconds = (FPlatformTime::Seconds() - ReplayStartTime) * ManagerReplaySpeed;
+
+    while (IsReplaying())
+    {
+        const FAdhocManagerRecord& Record = ReplayRecords[ReplayPosition];
+        if (ManagerReplaySpeed > 0 && (Record.Timestamp - FirstTimestamp).GetTotalSeconds() > ReplaySeconds)
+        {
+            break;
+        }
+        ReplayPosition++;
+
+        if (Record.Kind == EAdhocManagerRecordKind::StompEvent)
+        {
+            HandleStompEvent(Record.Name, Record.Body, FTCHARToUTF8(*Record.Body).Length());
+        }
+        else
+        {
+            ReplayResponse(Record);
+        }
+    }
+
+    if (!IsReplaying())
+    {
+        UE_LOG(LogAdhocGameModeComponent, Log, TEXT("Replay finished: Replayed=%d Skipped=%d Seconds=%f RecordedSeconds=%f"),
+            ReplayRecords.Num(), NumReplaySkipped, FPlatformTime::Seconds() - ReplayStartTime, (ReplayRecords.Last().Timestamp - FirstTimestamp).GetTotalSeconds());
+    }
+}
+
+void UAdhocGameModeComponent::ReplayResponse(const FAdhocManagerRecord& Record)
+{
+    FAdhocManagerResponse Response;
+    Response.bReceived = Record.bReceived;
+    Response.ResponseCode = Record.ResponseCode;
+    Response.Content = Record.Body;
+    Response.Attempts = Record.Attempts;
+    Response.Latency = Record.Latency;
+
+    const bool bGet = Record.Request.StartsWith(TEXT("GET "));
+    const bool bDelta = Record.Request.Contains(TEXT("sinceVersion="));
+
+    if (Record.Name.Equals(TEXT("factions")))
+    {
+        OnFactionsResponse(Response, bDelta);
+    }
+    else if (Record.Name.Equals(TEXT("servers")))
+    {
+        OnServersResponse(Response, bDelta, false);
+    }
+    else if (Record.Name.Equals(TEXT("areas")))
+    {
+        OnAreasResponse(Response);
+    }
+    else if (Record.Name.Equals(TEXT("objectives")))
+    {
+        if (bGet)
+        {
+            OnRetrieveObjectivesResponse(Response);
+        }
+        else
+        {
+            OnObjectivesResponse(Response);
+        }
+    }
+#if WITH_ADHOC_PLUGIN_EXTRA
+    else if (Record.Name.Equals(TEXT("structures")))
+    {
+        OnStructurePageResponse(Response);
+    }
+#endif
+    else
+    {
+        // e.g. user joins / navigates - the controllers they were for do not exist in the replay (and the user token key is not recorded)
+        UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Not replaying response: Endpoint=%s Request=%s"), *Record.Name, *Record.Request);
+        NumReplaySkipped++;
+    }
+}
+
+void UAdhocGameModeComponent::OnCollectMetrics(FAdhocMetrics& Metrics) const
+{
+    if (ManagerClient)
+    {
+        Metrics.SetGauge(TEXT("adhoc_manager_requests_in_flight"), FString(), ManagerClient->GetNumInFlightRequests());
+        Metrics.SetGauge(TEXT("adhoc_manager_requests_queued"), FString(), ManagerClient->GetNumQueuedRequests());
+    }
+
+    Metrics.SetGauge(TEXT("adhoc_server_started"), FString(), bServerStarted ? 1 : 0);
+    Metrics.SetGauge(TEXT("adhoc_players"), FString(), GameMode->GetNumPlayers());
+    Metrics.SetGauge(TEXT("adhoc_active_areas"), FString(), AdhocGameState->GetActiveAreaIndexes().Num());
+
+    TMap<FName, FAdhocEventSequencer::FStreamStats> EventStreamStats;
+    EventSequencer.GetStats(EventStreamStats);
+    for (const TPair<FName, FAdhocEventSequencer::FStreamStats>& StatsPair : EventStreamStats)
+    {
+        const FString StreamLabel = FAdhocMetrics::Label(TEXT("stream"), StatsPair.Key.ToString());
+        Metrics.SetGauge(TEXT("adhoc_event_reorder_depth"), StreamLabel, StatsPair.Value.ReorderDepth);
+        Metrics.SetGauge(TEXT("adhoc_event_reorder_depth_max"), StreamLabel, StatsPair.Value.MaxReorderDepth);
+        Metrics.SetCounter(TEXT("adhoc_event_gaps_total"), StreamLabel, StatsPair.Value.NumGaps);
+        Metrics.SetCounter(TEXT("adhoc_event_missed_total"), StreamLabel, StatsPair.Value.NumMissed);
+    }
+    for (const TPair<FName, int64>& ResyncCount : EventResyncCounts)
+    {
+        Metrics.SetCounter(TEXT("adhoc_event_resyncs_total"), FAdhocMetrics::Label(TEXT("stream"), ResyncCount.Key.ToString()), ResyncCount.Value);
+    }
+
+#if WITH_ADHOC_PLUGIN_EXTRA
+    Metrics.SetGauge(TEXT("adhoc_emission_playback_queued"), FString(), EmissionPlaybackQueue.Num());
+    Metrics.SetCounter(TEXT("adhoc_emissions_played_total"), FString(), EmissionPlaybackQueue.GetNumPlayed());
+    Metrics.SetCounter(TEXT("adhoc_emissions_late_total"), FString(), EmissionPlaybackQueue.GetNumLate());
+    Metrics.SetCounter(TEXT("adhoc_emissions_dropped_total"), FString(), EmissionPlaybackQueue.GetNumDropped());
+    Metrics.SetGauge(TEXT("adhoc_pending_structures"), FString(), AdhocGameState->GetPendingStructures().Num());
+#endif
+}
+
+void UAdhocGameModeComponent::OnTimer_MetricsFile() const
+{
+    FAdhocMetrics::Get().SaveToFile(MetricsFile);
+}
+
+void UAdhocGameModeComponent::OnTimer_StateResync()
+{
+    ADHOC_SCOPE(OnTimer_StateResync);
+
+    const FAdhocMetrics::FScopedTimer MetricsTimer(TEXT("adhoc_timer_seconds"), FAdhocMetrics::Label(TEXT("timer"), TEXT("StateResync")));
+
+    // deltas cannot express deletions (e.g. a server which has gone away) so every so often replace everything
+    NumStateResyncs++;
+    const bool bFull = StateFullResyncEvery > 0 && NumStateResyncs % StateFullResyncEvery == 0;
+
+    RetrieveFactions(bFull);
+    RetrieveServers(bFull);
+}
+
+void UAdhocGameModeComponent::ShutdownIfNotStarted() const
+{
+    // failures once we are up and running (e.g. periodic resyncs) just mean we try again later
+    if (!bServerStarted)
+    {
+        ShutdownIfNotInEditor();
+    }
+}
+
+// PUT AREAS (the map defines the areas, and should override what is on the server, but the server will choose the IDs)
+void UAdhocGameModeComponent::SubmitAreas()
+{
+    ADHOC_SCOPE(SubmitAreas);
+
+    const FAdhocStartupTimeline::FScope TimelineScope(StartupTimeline, TEXT("Build areas"), TEXT("json"));
+    const FAdhocMetrics::FScopedTimer MetricsTimer(TEXT("adhoc_json_seconds"), FAdhocMetrics::Label(TEXT("operation"), TEXT("build_areas")));
+
+    FString JsonString;
+    FAdhocManagerJson::WriteAreas(AdhocGameState->GetAreas(), JsonString);
+
+    ManagerClient->Post(TEXT("areas"), FString::Printf(TEXT("servers/%d/areas"), AdhocGameState->GetServerID()), JsonString,
+        FAdhocManagerResponseDelegate::CreateUObject(this, &UAdhocGameModeComponent::OnAreasResponse));
+}
+
+void UAdhocGameModeComponent::OnAreasResponse(const FAdhocManagerResponse& Response)
+{
+    ADHOC_SCOPE(OnAreasResponse);
+
+    const FAdhocStartupTimeline::FScope TimelineScope(StartupTimeline, TEXT("Parse areas"), TEXT("json"));
+    const FAdhocMetrics::FScopedTimer MetricsTimer(TEXT("adhoc_json_seconds"), FAdhocMetrics::Label(TEXT("operation"), TEXT("parse_areas")));
+
+    ADHOC_LOG_BODY(LogAdhocGameModeComponent, Verbose, Response.Content, TEXT("Areas response: ResponseCode=%d"), Response.ResponseCode);
+
+    if (!Response.IsOk())
+    {
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Areas response failure: ResponseCode=%d Content=%s"), Response.ResponseCode, *FAdhocBodyLog::Truncate(Response.Content));
+        ShutdownIfNotInEditor();
+        return;
+    }
+
+    TArray<FAdhocAreaState> Areas;
+    if (!FAdhocManagerJson::ParseAreas(Response.Content, Areas))
+    {
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to deserialize areas response: %s"), *FAdhocBodyLog::Truncate(Response.Content));
+        FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_json_deserialize_failures_total"), FAdhocMetrics::Label(TEXT("source"), TEXT("areas")));
+        ShutdownIfNotInEditor();
+        return;
+    }
 
-        // Writer->WriteArrayStart(TEXT("linkedObjectiveIds"));
-        // for (auto& LinkedObjectiveActor : ObjectiveActor->GetLinkedObjectiveInterfaces())
+    for (int i = 0; i < Areas.Num(); i++)
+    {
+        // // any area actors in this region should be updated with IDs etc.
+        // if (Areas[i].RegionID == AdhocGameState->GetRegionID())
         // {
-        // 	Writer->WriteValue(LinkedObjectiveActor->GetObjectiveID());
+        // 	for (TActorIterator<AAreaVolume> AreaVolumeIter(GetWorld()); AreaVolumeIter; ++AreaVolumeIter)
+        // 	{
+        // 		AAreaVolume* AreaVolume = *AreaVolumeIter;
+        // 		if (AreaVolume->GetAreaIndex() == Areas[i].Index)
+        // 		{
+        // 			AreaVolume->SetAreaID(Areas[i].ID);
+        // 		}
+        // 	}
         // }
-        // Writer->WriteArrayEnd();
-        Writer->WriteArrayStart(TEXT("linkedObjectiveIndexes"));
+    }
+
+    AdhocGameState->SetAreas(Areas);
+    UpdateAreaEventSubscriptions();
+
+    SubmitObjectives();
+}
+
+// PUT OBJECTIVES (the map defines the objectives, and should override what is on the server, but the server will choose the IDs)
+void UAdhocGameModeComponent::SubmitObjectives()
+{
+    ADHOC_SCOPE(SubmitObjectives);
+
+    const FAdhocStartupTimeline::FScope TimelineScope(StartupTimeline, TEXT("Build objectives"), TEXT("json"));
+    const FAdhocMetrics::FScopedTimer MetricsTimer(TEXT("adhoc_json_seconds"), FAdhocMetrics::Label(TEXT("operation"), TEXT("build_objectives")));
+
+    TArray<FAdhocObjectiveState> Objectives;
+    for (TActorIterator<AActor> ActorIter(GetWorld()); ActorIter; ++ActorIter)
+    {
+        const AActor* Actor = *ActorIter;
+        UAdhocObjectiveComponent* AdhocObjective = Cast<UAdhocObjectiveComponent>(Actor->GetComponentByClass(UAdhocObjectiveComponent::StaticClass()));
+        if (!AdhocObjective)
+        {
+            continue;
+        }
+
+        // ignore objectives outside an area
+        if (AdhocObjective->GetAreaIndexSafe() == -1)
+        {
+            UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Objective %d has no area!"), AdhocObjective->GetObjectiveIndex());
+            continue;
+        }
+
+        FAdhocObjectiveState& Objective = Objectives.AddDefaulted_GetRef();
+        Objective.Index = AdhocObjective->GetObjectiveIndex();
+        Objective.Name = AdhocObjective->GetFriendlyName();
+        Objective.Location = Actor->GetActorLocation();
+        Objective.InitialFactionIndex = AdhocObjective->GetInitialFactionIndex();
+        Objective.AreaIndex = AdhocObjective->GetAreaIndexSafe();
+
         for (auto& LinkedObjectiveActor : AdhocObjective->GetLinkedObjectives())
         {
             const UAdhocObjectiveComponent* LinkedAdhocObjective = Cast<UAdhocObjectiveComponent>(LinkedObjectiveActor->GetComponentByClass(UAdhocObjectiveComponent::StaticClass()));
@@ -1138,81 +2694,45 @@ void UAdhocGameModeComponent::SubmitObjectives()
                 continue;
             }
 
-            Writer->WriteValue(LinkedAdhocObjective->GetObjectiveIndex());
+            Objective.LinkedObjectiveIndexes.Add(LinkedAdhocObjective->GetObjectiveIndex());
         }
-        Writer->WriteArrayEnd();
-
-        // Writer->WriteValue(FString("areaId"), ObjectiveActor->GetAreaVolume()->GetAreaID());
-        Writer->WriteValue(TEXT("areaIndex"), AdhocObjective->GetAreaIndexSafe());
-
-        Writer->WriteObjectEnd();
     }
-    Writer->WriteArrayEnd();
 
-    Writer->Close();
-
-    const auto& Request = Http->CreateRequest();
-    Request->OnProcessRequestComplete().BindUObject(this, &UAdhocGameModeComponent::OnObjectivesResponse);
-    const FString URL = FString::Printf(TEXT("http://%s:80/adhoc_api/servers/%d/objectives"), *ManagerHost, AdhocGameState->GetServerID());
-    Request->SetURL(URL);
-    Request->SetVerb("POST");
-    Request->SetHeader("Content-Type", "application/json");
-    Request->SetHeader(BasicAuthHeaderName, BasicAuthHeaderValue);
-    Request->SetContentAsString(JsonString);
+    FString JsonString;
+    FAdhocManagerJson::WriteObjectives(AdhocGameState->GetRegionID(), Objectives, JsonString);
 
-    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("PUT %s: %s"), *URL, *JsonString);
-    Request->ProcessRequest();
+    ManagerClient->Post(TEXT("objectives"), FString::Printf(TEXT("servers/%d/objectives"), AdhocGameState->GetServerID()), JsonString,
+        FAdhocManagerResponseDelegate::CreateUObject(this, &UAdhocGameModeComponent::OnObjectivesResponse));
 }
 
-void UAdhocGameModeComponent::OnObjectivesResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void UAdhocGameModeComponent::OnObjectivesResponse(const FAdhocManagerResponse& Response)
 {
-    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Objectives response: ResponseCode=%d Content=%s"), Response->GetResponseCode(), *Response->GetContentAsString());
+    ADHOC_SCOPE(OnObjectivesResponse);
+
+    const FAdhocStartupTimeline::FScope TimelineScope(StartupTimeline, TEXT("Parse objectives"), TEXT("json"));
+    const FAdhocMetrics::FScopedTimer MetricsTimer(TEXT("adhoc_json_seconds"), FAdhocMetrics::Label(TEXT("operation"), TEXT("parse_objectives")));
 
-    if (!bWasSuccessful || Response->GetResponseCode() != 200)
+    ADHOC_LOG_BODY(LogAdhocGameModeComponent, Verbose, Response.Content, TEXT("Objectives response: ResponseCode=%d"), Response.ResponseCode);
+
+    if (!Response.IsOk())
     {
-        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Objectives response failure: ResponseCode=%d Content=%s"), Response->GetResponseCode(), *Response->GetContentAsString());
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Objectives response failure: ResponseCode=%d Content=%s"), Response.ResponseCode, *FAdhocBodyLog::Truncate(Response.Content));
         ShutdownIfNotInEditor();
         return;
     }
 
-    const auto& Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
-    TArray<TSharedPtr<FJsonValue>> JsonValues;
-    if (!FJsonSerializer::Deserialize(Reader, JsonValues))
+    TArray<FAdhocObjectiveState> Objectives;
+    if (!FAdhocManagerJson::ParseObjectives(Response.Content, Objectives))
     {
-        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to deserialize objectives response: %s"), *Response->GetContentAsString());
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to deserialize objectives response: %s"), *FAdhocBodyLog::Truncate(Response.Content));
+        FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_json_deserialize_failures_total"), FAdhocMetrics::Label(TEXT("source"), TEXT("objectives")));
         ShutdownIfNotInEditor();
         return;
     }
 
-    TArray<FAdhocObjectiveState> Objectives;
-    Objectives.SetNum(JsonValues.Num());
-
     for (int i = 0; i < Objectives.Num(); i++)
     {
-        const TSharedPtr<FJsonObject> JsonObject = JsonValues[i]->AsObject();
-        Objectives[i].ID = JsonObject->GetIntegerField("id");
-        Objectives[i].Name = JsonObject->GetStringField("name");
-        Objectives[i].RegionID = JsonObject->GetIntegerField("regionId");
-        Objectives[i].Index = JsonObject->GetIntegerField("index");
-        JsonObject->TryGetNumberField(TEXT("initialFactionId"), Objectives[i].InitialFactionID);
-        JsonObject->TryGetNumberField(TEXT("initialFactionIndex"), Objectives[i].InitialFactionIndex);
-        JsonObject->TryGetNumberField(TEXT("factionId"), Objectives[i].FactionID);
-        JsonObject->TryGetNumberField(TEXT("factionIndex"), Objectives[i].FactionIndex);
-        JsonObject->TryGetNumberField(TEXT("areaId"), Objectives[i].AreaID);
-        JsonObject->TryGetNumberField(TEXT("areaIndex"), Objectives[i].AreaIndex);
-
-        TArray<int64> LinkedObjectiveIDs;
-        for (auto& LinkedObjectiveID : JsonObject->GetArrayField("linkedObjectiveIds"))
-        {
-            LinkedObjectiveIDs.AddUnique(LinkedObjectiveID->AsNumber());
-        }
-        TArray<int32> LinkedObjectiveIndexes;
-        for (auto& LinkedObjectiveIndex : JsonObject->GetArrayField("linkedObjectiveIndexes"))
-        {
-            LinkedObjectiveIndexes.AddUnique(LinkedObjectiveIndex->AsNumber());
-        }
-        Objectives[i].LinkedObjectiveIDs = LinkedObjectiveIDs;
-        Objectives[i].LinkedObjectiveIndexes = LinkedObjectiveIndexes;
+        ObjectivesVersion = FMath::Max(ObjectivesVersion, Objectives[i].Version);
 
         if (Objectives[i].RegionID == AdhocGameState->GetRegionID())
         {
@@ -1235,14 +2755,85 @@ void UAdhocGameModeComponent::OnObjectivesResponse(FHttpRequestPtr Request, FHtt
     }
 
     AdhocGameState->SetObjectives(Objectives);
+    SeedEventStream(TEXT("objectives"), ObjectivesVersion);
 
 #if WITH_ADHOC_PLUGIN_EXTRA
+    if (bPagedStructureSync)
+    {
+        StartStructureSync();
+        return;
+    }
+
     SubmitStructures();
 #else
     ServerStarted();
 #endif
 }
 
+void UAdhocGameModeComponent::RetrieveObjectives()
+{
+    FString Path = FString::Printf(TEXT("servers/%d/objectives"), AdhocGameState->GetServerID());
+    if (ObjectivesVersion >= 0)
+    {
+        Path += FString::Printf(TEXT("?sinceVersion=%lld"), ObjectivesVersion);
+    }
+
+    ManagerClient->Get(TEXT("objectives"), Path,
+        FAdhocManagerResponseDelegate::CreateUObject(this, &UAdhocGameModeComponent::OnRetrieveObjectivesResponse));
+}
+
+void UAdhocGameModeComponent::OnRetrieveObjectivesResponse(const FAdhocManagerResponse& Response)
+{
+    ADHOC_SCOPE(OnRetrieveObjectivesResponse);
+
+    ADHOC_LOG_BODY(LogAdhocGameModeComponent, Verbose, Response.Content, TEXT("Retrieve objectives response: ResponseCode=%d"), Response.ResponseCode);
+
+    if (!Response.IsOk())
+    {
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Retrieve objectives response failure: ResponseCode=%d Content=%s"), Response.ResponseCode, *FAdhocBodyLog::Truncate(Response.Content));
+        PendingEventResyncs.Add(TEXT("objectives"));
+        return;
+    }
+
+    const auto& Reader = TJsonReaderFactory<>::CreateFromView(Response.Content);
+    TArray<TSharedPtr<FJsonValue>> JsonValues;
+    if (!FJsonSerializer::Deserialize(Reader, JsonValues))
+    {
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to deserialize retrieve objectives response: %s"), *FAdhocBodyLog::Truncate(Response.Content));
+        FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_json_deserialize_failures_total"), FAdhocMetrics::Label(TEXT("source"), TEXT("retrieve_objectives")));
+        PendingEventResyncs.Add(TEXT("objectives"));
+        return;
+    }
+
+    // only the faction can change after startup, so apply any difference as if we had received the ObjectiveTaken event
+    int32 NumChanged = 0;
+    for (const TSharedPtr<FJsonValue>& JsonValue : JsonValues)
+    {
+        const TSharedPtr<FJsonObject> JsonObject = JsonValue->AsObject();
+
+        int64 Version = -1;
+        int64 FactionID = -1;
+        JsonObject->TryGetNumberField(TEXT("version"), Version);
+        JsonObject->TryGetNumberField(TEXT("factionId"), FactionID);
+        ObjectivesVersion = FMath::Max(ObjectivesVersion, Version);
+
+        FAdhocObjectiveState* Objective = AdhocGameState->FindObjectiveByID(JsonObject->GetIntegerField("id"));
+        FAdhocFactionState* Faction = AdhocGameState->FindFactionByID(FactionID);
+        if (!Objective || !Faction || Objective->FactionID == FactionID)
+        {
+            continue;
+        }
+
+        Objective->Version = Version;
+        OnObjectiveTakenEvent(*Objective, *Faction);
+        NumChanged++;
+    }
+
+    SeedEventStream(TEXT("objectives"), ObjectivesVersion);
+
+    UE_LOG(LogAdhocGameModeComponent, Log, TEXT("Objectives resync: Received=%d Changed=%d Version=%lld"), JsonValues.Num(), NumChanged, ObjectivesVersion);
+}
+
 void UAdhocGameModeComponent::ServerStarted()
 {
     FString JsonString;
@@ -1255,16 +2846,42 @@ void UAdhocGameModeComponent::ServerStarted()
     Writer->WriteObjectEnd();
     Writer->Close();
 
-    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Sending: %s"), *JsonString);
-    StompClient->Send("/app/ServerStarted", JsonString);
+    ADHOC_LOG_BODY(LogAdhocGameModeComponent, Verbose, JsonString, TEXT("Sending:"));
+    SendStompMessage(TEXT("/app/ServerStarted"), JsonString);
 
     bServerStarted = true;
 
+#if WITH_ADHOC_PLUGIN_EXTRA
+    if (!bPagedStructureSync)
+    {
+        AdoptBulkLoadedStructures();
+    }
+#endif
+
+    StartupTimeline.EndPhase(TEXT("StructureSync"));
+    StartupTimeline.MarkReady();
+    StartupTimeline.LogReport();
+    if (!StartupTimelineFile.IsEmpty())
+    {
+        StartupTimeline.SaveJson(StartupTimelineFile);
+    }
+
     GetWorld()->GetTimerManager().SetTimer(TimerHandle_ServerPawns, this, &UAdhocGameModeComponent::OnTimer_ServerPawns, 5, true, 5);
 
+    if (StateResyncInterval > 0)
+    {
+        GetWorld()->GetTimerManager().SetTimer(TimerHandle_StateResync, this, &UAdhocGameModeComponent::OnTimer_StateResync, StateResyncInterval, true, StateResyncInterval);
+    }
+
 #if WITH_ADHOC_PLUGIN_EXTRA
-    GetWorld()->GetTimerManager().SetTimer(TimerHandle_RecentEmissions, this, &UAdhocGameModeComponent::OnTimer_RecentEmissions, 2, true, 2);
+    GetWorld()->GetTimerManager().SetTimer(TimerHandle_RecentEmissions, this, &UAdhocGameModeComponent::OnTimer_SendRecentEmissions, 2, true, 2);
 #endif
+
+    if (BotPoolSize > 0)
+    {
+        RefillBotPool();
+        GetWorld()->GetTimerManager().SetTimer(TimerHandle_BotPool, this, &UAdhocGameModeComponent::RefillBotPool, 5, true, 5);
+    }
 }
 
 void UAdhocGameModeComponent::OnServerUpdatedEvent(int32 EventServerID, int32 EventRegionID, const bool bEventEnabled, const bool bEventActive, const FString& EventPrivateIP,
@@ -1304,7 +2921,7 @@ void UAdhocGameModeComponent::OnServerUpdatedEvent(int32 EventServerID, int32 Ev
     }
 }
 
-void UAdhocGameModeComponent::SetActiveAreas(const int32 RegionID, const TArray<int32>& AreaIndexes) const
+void UAdhocGameModeComponent::SetActiveAreas(const int32 RegionID, const TArray<int32>& AreaIndexes)
 {
     if (RegionID != AdhocGameState->GetRegionID())
     {
@@ -1318,6 +2935,12 @@ void UAdhocGameModeComponent::SetActiveAreas(const int32 RegionID, const TArray<
             UE_LOG(LogAdhocGameModeComponent, Log, TEXT("This server has active area index %d"), AreaIndex);
         }
         AdhocGameState->SetActiveAreaIndexes(AreaIndexes);
+
+#if WITH_ADHOC_PLUGIN_EXTRA
+        UpdateStructureResidencies();
+#endif
+
+        UpdateAreaEventSubscriptions();
     }
 }
 
@@ -1326,7 +2949,7 @@ void UAdhocGameModeComponent::OnWorldUpdatedEvent(int64 WorldWorldID, int64 Worl
     ManagerHosts = WorldManagerHosts;
 }
 
-void UAdhocGameModeComponent::SubmitUserJoin(UAdhocControllerComponent* AdhocController)
+void UAdhocGameModeComponent::SubmitUserJoin(UAdhocControllerComponent* AdhocController, const bool bAlreadyAdmitted)
 {
     FString JsonString;
     const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
@@ -1360,31 +2983,51 @@ void UAdhocGameModeComponent::SubmitUserJoin(UAdhocControllerComponent* AdhocCon
     Writer->WriteObjectEnd();
     Writer->Close();
 
-    const auto& Request = Http->CreateRequest();
-    Request->OnProcessRequestComplete().BindUObject(this, &UAdhocGameModeComponent::OnUserJoinResponse, AdhocController, true);
-    const FString URL = FString::Printf(TEXT("http://%s:80/adhoc_api/servers/%d/userJoin"), *ManagerHost, AdhocGameState->GetServerID());
-    Request->SetURL(URL);
-    Request->SetVerb("POST");
-    Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-    // Request->SetHeader(TEXT("X-CSRF-TOKEN"), TEXT("SERVER"));
-    Request->SetHeader(BasicAuthHeaderName, BasicAuthHeaderValue);
-    Request->SetContentAsString(JsonString);
-
-    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("POST %s: %s"), *URL, *JsonString);
-    Request->ProcessRequest();
+    ManagerClient->Post(TEXT("userJoin"), FString::Printf(TEXT("servers/%d/userJoin"), AdhocGameState->GetServerID()), JsonString,
+        FAdhocManagerResponseDelegate::CreateUObject(this, &UAdhocGameModeComponent::OnUserJoinResponse, AdhocController, true, bAlreadyAdmitted));
 }
 
-void UAdhocGameModeComponent::OnUserJoinResponse(
-    FHttpRequestPtr Request, const FHttpResponsePtr Response, const bool bWasSuccessful, UAdhocControllerComponent* AdhocController, const bool bKickOnFailure)
+void UAdhocGameModeComponent::OnUserJoinResponse(const FAdhocManagerResponse& Response, UAdhocControllerComponent* AdhocController,
+    const bool bKickOnFailure, const bool bAlreadyAdmitted)
 {
-    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("User join response: ResponseCode=%d Content=%s"), Response->GetResponseCode(), *Response->GetContentAsString());
+    ADHOC_LOG_BODY(LogAdhocGameModeComponent, Verbose, Response.Content, TEXT("User join response: ResponseCode=%d"), Response.ResponseCode);
 
     AController* Controller = AdhocController->GetOwner<AController>();
     APlayerController* PlayerController = Cast<APlayerController>(Controller);
 
-    if (!bWasSuccessful || Response->GetResponseCode() != 200)
+    if (!Response.IsOk())
     {
-        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("User join response failure: ResponseCode=%d Content=%s"), Response->GetResponseCode(), *Response->GetContentAsString());
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("User join response failure: ResponseCode=%d Content=%s"),
+            Response.ResponseCode, *FAdhocBodyLog::Truncate(Response.Content));
+
+        // an optimistically admitted user is only kicked if the manager definitively rejected them (rather than e.g. the manager being unavailable)
+        if (bAlreadyAdmitted && PlayerController)
+        {
+            const int32 ResponseCode = Response.ResponseCode;
+            if (ResponseCode < 400 || ResponseCode >= 500)
+            {
+                UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("User join could not be confirmed for admitted user %lld - leaving them in game"), AdhocController->GetUserID());
+                return;
+            }
+
+            // do not let the rejected token admit the user again
+            const UAdhocPlayerControllerComponent* AdhocPlayerController = CastChecked<UAdhocPlayerControllerComponent>(AdhocController);
+            VerifiedUsers.Remove(TPair<int64, FString>(AdhocPlayerController->GetUserID(), AdhocPlayerController->GetToken()));
+        }
+
+        // a pooled bot user was rejected by the manager - the bot is already in play so just have the manager pick/register another bot user for it
+        // (only once, and only on a definitive rejection - if the manager is unavailable the bot keeps its pooled user)
+        if (bAlreadyAdmitted && !PlayerController)
+        {
+            if (AdhocController->GetUserID() != -1 && Response.ResponseCode >= 400 && Response.ResponseCode < 500)
+            {
+                UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Pooled bot user %lld was rejected - submitting a new bot user join"), AdhocController->GetUserID());
+                AdhocController->SetUserID(-1);
+                SubmitUserJoin(AdhocController, true);
+            }
+            return;
+        }
+
         if (PlayerController && bKickOnFailure)
         {
             UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Login failure - should kick player"));
@@ -1397,11 +3040,17 @@ void UAdhocGameModeComponent::OnUserJoinResponse(
         return;
     }
 
-    const auto& Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+    const auto& Reader = TJsonReaderFactory<>::CreateFromView(Response.Content);
     TSharedPtr<FJsonObject> JsonObject;
     if (!FJsonSerializer::Deserialize(Reader, JsonObject))
     {
-        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to deserialize user join response: %s"), *Response->GetContentAsString());
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to deserialize user join response: %s"), *FAdhocBodyLog::Truncate(Response.Content));
+        FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_json_deserialize_failures_total"), FAdhocMetrics::Label(TEXT("source"), TEXT("user_join")));
+        if (bAlreadyAdmitted)
+        {
+            return;
+        }
+
         if (PlayerController && bKickOnFailure)
         {
             UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Login failure - should kick player"));
@@ -1458,6 +3107,45 @@ void UAdhocGameModeComponent::OnUserJoinResponse(
         }
     }
 
+    ApplyUserJoin(AdhocController, UserID, UserName, FactionIndex);
+
+    // remember the user so a repeat join with the same token does not need to wait on the manager
+    const UAdhocPlayerControllerComponent* AdhocPlayerController = Cast<UAdhocPlayerControllerComponent>(AdhocController);
+    if (AdhocPlayerController && !AdhocPlayerController->GetToken().IsEmpty())
+    {
+        FAdhocUserState User;
+        User.ID = UserID;
+        User.Name = UserName;
+        User.FactionID = UserFactionID;
+        CacheVerifiedUser(UserID, AdhocPlayerController->GetToken(), User, AdhocController->GetImmediateSpawnTransform());
+    }
+
+    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("User join success: UserID=%d UserName=%s UserFactionID=%d FactionIndex=%d"), UserID, *UserName, UserFactionID, FactionIndex);
+
+    // user was already admitted so the manager response has just reconciled the details
+    if (bAlreadyAdmitted)
+    {
+        return;
+    }
+
+    TOptional<FTransform> ImmediateSpawnTransform = AdhocController->GetImmediateSpawnTransform();
+    if (ImmediateSpawnTransform.IsSet())
+    {
+        const FVector ImmediateSpawnLocation = ImmediateSpawnTransform->GetLocation();
+        const FRotator ImmediateSpawnRotation = ImmediateSpawnTransform->GetRotation().Rotator();
+
+        UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Immediately spawning location: X=%f Y=%f Z=%f Yaw=%f Pitch=%f Roll=%f"), ImmediateSpawnLocation.X,
+            ImmediateSpawnLocation.Y, ImmediateSpawnLocation.Z, ImmediateSpawnRotation.Yaw, ImmediateSpawnRotation.Pitch, ImmediateSpawnRotation.Roll);
+    }
+
+    OnUserJoinSuccess(AdhocController);
+}
+
+void UAdhocGameModeComponent::ApplyUserJoin(UAdhocControllerComponent* AdhocController, const int64 UserID, const FString& UserName, const int32 FactionIndex) const
+{
+    const AController* Controller = AdhocController->GetOwner<AController>();
+    check(Controller);
+
     AdhocController->SetFriendlyName(UserName);
     AdhocController->SetFactionIndex(FactionIndex);
 
@@ -1496,20 +3184,6 @@ void UAdhocGameModeComponent::OnUserJoinResponse(
             AdhocPawn->SetFactionIndex(FactionIndex);
         }
     }
-
-    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("User join success: UserID=%d UserName=%s UserFactionID=%d FactionIndex=%d"), UserID, *UserName, UserFactionID, FactionIndex);
-
-    TOptional<FTransform> ImmediateSpawnTransform = AdhocController->GetImmediateSpawnTransform();
-    if (ImmediateSpawnTransform.IsSet())
-    {
-        const FVector ImmediateSpawnLocation = ImmediateSpawnTransform->GetLocation();
-        const FRotator ImmediateSpawnRotation = ImmediateSpawnTransform->GetRotation().Rotator();
-
-        UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Immediately spawning location: X=%f Y=%f Z=%f Yaw=%f Pitch=%f Roll=%f"), ImmediateSpawnLocation.X,
-            ImmediateSpawnLocation.Y, ImmediateSpawnLocation.Z, ImmediateSpawnRotation.Yaw, ImmediateSpawnRotation.Pitch, ImmediateSpawnRotation.Roll);
-    }
-
-    OnUserJoinSuccess(AdhocController);
 }
 
 void UAdhocGameModeComponent::OnUserJoinSuccess(const UAdhocControllerComponent* AdhocController) const
@@ -1530,6 +3204,187 @@ void UAdhocGameModeComponent::OnUserJoinFailure(const UAdhocControllerComponent*
     OnUserJoinFailureDelegate.Broadcast(Controller);
 }
 
+void UAdhocGameModeComponent::CacheVerifiedUser(const int64 UserID, const FString& Token, const FAdhocUserState& User, const TOptional<FTransform>& LastTransform) const
+{
+    if (VerifiedUserCacheTTL <= 0 || UserID == -1 || Token.IsEmpty())
+    {
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+
+    // joins are infrequent enough that we can just sweep out expired entries whenever we add one
+    for (auto It = VerifiedUsers.CreateIterator(); It; ++It)
+    {
+        if (It.Value().ExpiryTime <= Now)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    FAdhocVerifiedUser& VerifiedUser = VerifiedUsers.FindOrAdd(TPair<int64, FString>(UserID, Token));
+    VerifiedUser.User = User;
+    VerifiedUser.LastTransform = LastTransform;
+    VerifiedUser.ExpiryTime = Now + VerifiedUserCacheTTL;
+}
+
+const FAdhocVerifiedUser* UAdhocGameModeComponent::FindVerifiedUser(const int64 UserID, const FString& Token) const
+{
+    if (VerifiedUserCacheTTL <= 0 || UserID == -1 || Token.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    const FAdhocVerifiedUser* VerifiedUser = VerifiedUsers.Find(TPair<int64, FString>(UserID, Token));
+    if (!VerifiedUser || VerifiedUser->ExpiryTime <= FPlatformTime::Seconds())
+    {
+        return nullptr;
+    }
+
+    return VerifiedUser;
+}
+
+void UAdhocGameModeComponent::UpdateVerifiedUserTransform(const UAdhocPlayerControllerComponent* AdhocPlayerController, const FTransform& LastTransform) const
+{
+    FAdhocVerifiedUser* VerifiedUser = VerifiedUsers.Find(TPair<int64, FString>(AdhocPlayerController->GetUserID(), AdhocPlayerController->GetToken()));
+    if (VerifiedUser)
+    {
+        VerifiedUser->LastTransform = LastTransform;
+    }
+}
+
+void UAdhocGameModeComponent::RefillBotPool()
+{
+    if (BotPoolSize <= 0 || !bServerStarted || FPlatformTime::Seconds() < BotPoolRefillTime)
+    {
+        return;
+    }
+
+    for (int32 FactionIndex = 0; FactionIndex < AdhocGameState->GetNumFactions(); FactionIndex++)
+    {
+        const int32 NumPooled = BotPool.FindOrAdd(FactionIndex).Num();
+        int32& NumPending = BotPoolPendingReservations.FindOrAdd(FactionIndex);
+
+        for (int32 i = NumPooled + NumPending; i < BotPoolSize; i++)
+        {
+            SubmitBotReservation(FactionIndex);
+            NumPending++;
+        }
+    }
+}
+
+void UAdhocGameModeComponent::SubmitBotReservation(const int32 FactionIndex)
+{
+    // a bot user join without a user ID will have the manager find (or register) a bot user for us
+    // (so the manager counts the bot user as joined to this server while it sits in the pool)
+    FString JsonString;
+    const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+        TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("serverId"), AdhocGameState->GetServerID());
+    Writer->WriteValue(TEXT("factionId"), AdhocGameState->GetFaction(FactionIndex).ID);
+    Writer->WriteValue(TEXT("human"), false);
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    ManagerClient->Post(TEXT("userJoin"), FString::Printf(TEXT("servers/%d/userJoin"), AdhocGameState->GetServerID()), JsonString,
+        FAdhocManagerResponseDelegate::CreateUObject(this, &UAdhocGameModeComponent::OnBotReservationResponse, FactionIndex));
+}
+
+void UAdhocGameModeComponent::OnBotReservationResponse(const FAdhocManagerResponse& Response, const int32 FactionIndex)
+{
+    int32& NumPending = BotPoolPendingReservations.FindOrAdd(FactionIndex);
+    NumPending = FMath::Max(0, NumPending - 1);
+
+    if (!Response.IsOk())
+    {
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Bot reservation response failure: ResponseCode=%d"), Response.ResponseCode);
+        return;
+    }
+
+    const auto& Reader = TJsonReaderFactory<>::CreateFromView(Response.Content);
+    TSharedPtr<FJsonObject> JsonObject;
+    if (!FJsonSerializer::Deserialize(Reader, JsonObject))
+    {
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to deserialize bot reservation response: %s"), *FAdhocBodyLog::Truncate(Response.Content));
+        FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_json_deserialize_failures_total"), FAdhocMetrics::Label(TEXT("source"), TEXT("bot_reservation")));
+        return;
+    }
+
+    FAdhocUserState BotUser;
+    BotUser.ID = JsonObject->GetIntegerField("id");
+    BotUser.Name = JsonObject->GetStringField("name");
+    BotUser.FactionID = JsonObject->GetIntegerField("factionId");
+
+    // the manager decides the faction of the bot user so pool it under whatever faction we actually got
+    const FAdhocFactionState* Faction = AdhocGameState->FindFactionByID(BotUser.FactionID);
+    if (!Faction)
+    {
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Bot reservation has unknown faction: UserID=%lld FactionID=%lld"), BotUser.ID, BotUser.FactionID);
+        return;
+    }
+
+    // the manager may hand back a bot user we already hold (pooled or assigned) - if it keeps doing so (e.g. it has run out of bot users)
+    // back off rather than asking again on every refill
+    bool bDuplicate = false;
+    for (const TPair<int32, TArray<FAdhocUserState>>& FactionBotPool : BotPool)
+    {
+        bDuplicate |= FactionBotPool.Value.ContainsByPredicate([&BotUser](const FAdhocUserState& PooledBotUser) { return PooledBotUser.ID == BotUser.ID; });
+    }
+    for (TActorIterator<AAIController> It(GetWorld()); It && !bDuplicate; ++It)
+    {
+        const UAdhocAIControllerComponent* AdhocBotController = Cast<UAdhocAIControllerComponent>((*It)->GetComponentByClass(UAdhocAIControllerComponent::StaticClass()));
+        bDuplicate = AdhocBotController && AdhocBotController->GetUserID() == BotUser.ID;
+    }
+    if (bDuplicate)
+    {
+        NumBotPoolDuplicates++;
+        const float BackoffSeconds = FMath::Min(5.0f * (1 << FMath::Min(NumBotPoolDuplicates, 6)), 300.0f);
+        BotPoolRefillTime = FPlatformTime::Seconds() + BackoffSeconds;
+
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Bot reservation returned a bot user we already hold (%d in a row) - not refilling the pool for %.0f seconds: UserID=%lld"),
+            NumBotPoolDuplicates, BackoffSeconds, BotUser.ID);
+        return;
+    }
+    NumBotPoolDuplicates = 0;
+
+    UE_LOG(LogAdhocGameModeComponent, VeryVerbose, TEXT("Reserved bot user: UserID=%lld UserName=%s FactionIndex=%d"), BotUser.ID, *BotUser.Name, Faction->Index);
+
+    BotPool.FindOrAdd(Faction->Index).Add(BotUser);
+}
+
+bool UAdhocGameModeComponent::TakeBotUserFromPool(const int32 FactionIndex, FAdhocUserState& OutBotUser, int32& OutFactionIndex)
+{
+    if (BotPoolSize <= 0)
+    {
+        return false;
+    }
+
+    // if the game logic has not chosen a faction for the bot, take from whichever faction has the most bot users available
+    OutFactionIndex = FactionIndex;
+    if (OutFactionIndex == -1)
+    {
+        int32 MostPooled = 0;
+        for (const TPair<int32, TArray<FAdhocUserState>>& FactionBotPool : BotPool)
+        {
+            if (FactionBotPool.Value.Num() > MostPooled)
+            {
+                MostPooled = FactionBotPool.Value.Num();
+                OutFactionIndex = FactionBotPool.Key;
+            }
+        }
+    }
+
+    TArray<FAdhocUserState>* FactionBotPool = BotPool.Find(OutFactionIndex);
+    if (!FactionBotPool || FactionBotPool->Num() <= 0)
+    {
+        return false;
+    }
+
+    OutBotUser = FactionBotPool->Pop();
+    return true;
+}
+
 void UAdhocGameModeComponent::SubmitNavigate(UAdhocPlayerControllerComponent* AdhocPlayerController, const int32 AreaID) const
 {
     const APlayerController* PlayerController = AdhocPlayerController->GetOwner<APlayerController>();
@@ -1556,37 +3411,28 @@ void UAdhocGameModeComponent::SubmitNavigate(UAdhocPlayerControllerComponent* Ad
     Writer->WriteObjectEnd();
     Writer->Close();
 
-    const auto& Request = Http->CreateRequest();
-    Request->OnProcessRequestComplete().BindUObject(this, &UAdhocGameModeComponent::OnNavigateResponse, AdhocPlayerController);
-    const FString URL =
-        FString::Printf(TEXT("http://%s:80/adhoc_api/servers/%d/userNavigate"), *ManagerHost, AdhocGameState->GetServerID());
-    Request->SetURL(URL);
-    Request->SetVerb("POST");
-    Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-    // Request->SetHeader(TEXT("X-CSRF-TOKEN"), TEXT("SERVER"));
-    Request->SetHeader(BasicAuthHeaderName, BasicAuthHeaderValue);
-    Request->SetContentAsString(JsonString);
+    UpdateVerifiedUserTransform(AdhocPlayerController, FTransform(FRotator(PlayerRotation.Pitch, PlayerRotation.Yaw, 0), PlayerLocation));
 
-    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("POST %s: %s"), *URL, *JsonString);
-    Request->ProcessRequest();
+    ManagerClient->Post(TEXT("userNavigate"), FString::Printf(TEXT("servers/%d/userNavigate"), AdhocGameState->GetServerID()), JsonString,
+        FAdhocManagerResponseDelegate::CreateUObject(this, &UAdhocGameModeComponent::OnNavigateResponse, AdhocPlayerController));
 }
 
-void UAdhocGameModeComponent::OnNavigateResponse(
-    FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, UAdhocPlayerControllerComponent* AdhocPlayerController) const
+void UAdhocGameModeComponent::OnNavigateResponse(const FAdhocManagerResponse& Response, UAdhocPlayerControllerComponent* AdhocPlayerController) const
 {
-    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Navigate response: ResponseCode=%d Content=%s"), Response->GetResponseCode(), *Response->GetContentAsString());
+    ADHOC_LOG_BODY(LogAdhocGameModeComponent, Verbose, Response.Content, TEXT("Navigate response: ResponseCode=%d"), Response.ResponseCode);
 
-    if (!bWasSuccessful || Response->GetResponseCode() != 200)
+    if (!Response.IsOk())
     {
-        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Navigate response failure: ResponseCode=%d Content=%s"), Response->GetResponseCode(), *Response->GetContentAsString());
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Navigate response failure: ResponseCode=%d Content=%s"), Response.ResponseCode, *FAdhocBodyLog::Truncate(Response.Content));
         return;
     }
 
-    const auto& Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+    const auto& Reader = TJsonReaderFactory<>::CreateFromView(Response.Content);
     TSharedPtr<FJsonObject> JsonObject;
     if (!FJsonSerializer::Deserialize(Reader, JsonObject))
     {
-        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to deserialize navigate response: %s"), *Response->GetContentAsString());
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to deserialize navigate response: %s"), *FAdhocBodyLog::Truncate(Response.Content));
+        FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_json_deserialize_failures_total"), FAdhocMetrics::Label(TEXT("source"), TEXT("navigate")));
         return;
     }
 
@@ -1596,12 +3442,15 @@ void UAdhocGameModeComponent::OnNavigateResponse(
     const FString UserToken = JsonObject->GetStringField("token");
     if (IP.IsEmpty() || Port <= 0 || WebSocketURL.IsEmpty() || UserToken.IsEmpty())
     {
-        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to process navigate response: %s"), *Response->GetContentAsString());
+        UE_LOG(LogAdhocGameModeComponent, Warning, TEXT("Failed to process navigate response: %s"), *FAdhocBodyLog::Truncate(Response.Content));
         return;
     }
 
     AdhocPlayerController->SetToken(UserToken);
 
+    APlayerController* PlayerController = AdhocPlayerController->GetOwner<APlayerController>();
+    check(PlayerController);
+
     FString URL = FString::Printf(TEXT("%s:%d"), *IP, Port);
 
     URL += FString::Printf(TEXT("?WebSocketURL=%s"), *WebSocketURL);
@@ -1626,9 +3475,6 @@ void UAdhocGameModeComponent::OnNavigateResponse(
     UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Player %s navigate via URL: %s"),
         *AdhocPlayerController->GetOwner<APlayerController>()->GetPlayerState<APlayerState>()->GetPlayerName(), *URL);
 
-    APlayerController* PlayerController = AdhocPlayerController->GetOwner<APlayerController>();
-    check(PlayerController);
-
     APawn* PlayerPawn = PlayerController->GetPawn();
     if (PlayerPawn)
     {
@@ -1640,21 +3486,16 @@ void UAdhocGameModeComponent::OnNavigateResponse(
 
 void UAdhocGameModeComponent::OnTimer_ServerPawns() const
 {
-    if (!StompClient || !StompClient->IsConnected() || !bServerStarted) { return; }
+    ADHOC_SCOPE(OnTimer_ServerPawns);
 
-    FString JsonString;
-    const auto& Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
-
-    Writer->WriteObjectStart();
-    Writer->WriteValue(TEXT("eventType"), TEXT("ServerPawns"));
-    Writer->WriteValue(TEXT("serverId"), AdhocGameState->GetServerID());
+    const FAdhocMetrics::FScopedTimer MetricsTimer(TEXT("adhoc_timer_seconds"), FAdhocMetrics::Label(TEXT("timer"), TEXT("ServerPawns")));
 
-    Writer->WriteArrayStart(TEXT("pawns"));
+    if (!StompClient || !StompClient->IsConnected() || !bServerStarted) { return; }
 
     UWorld* World = GetWorld();
     check(World);
 
-    int32 PawnIndex = 0;
+    TArray<FAdhocServerPawn> Pawns;
     for (TActorIterator<APawn> It = TActorIterator<APawn>(World); It; ++It)
     {
         const UAdhocPawnComponent* AdhocPawn = Cast<UAdhocPawnComponent>((*It)->GetComponentByClass(UAdhocPawnComponent::StaticClass()));
@@ -1663,57 +3504,36 @@ void UAdhocGameModeComponent::OnTimer_ServerPawns() const
             continue;
         }
 
-        Writer->WriteObjectStart();
-        Writer->WriteValue(TEXT("uuid"), AdhocPawn->GetUUID().ToString(EGuidFormats::DigitsWithHyphens));
-        Writer->WriteValue(TEXT("name"), AdhocPawn->GetFriendlyName());
-        Writer->WriteValue(TEXT("description"), AdhocPawn->GetDescription());
-        Writer->WriteValue(TEXT("serverId"), AdhocGameState->GetServerID());
-        Writer->WriteValue(TEXT("index"), PawnIndex);
-
-        Writer->WriteValue(TEXT("x"), (*It)->GetActorLocation().X);
-        Writer->WriteValue(TEXT("y"), -(*It)->GetActorLocation().Y);
-        Writer->WriteValue(TEXT("z"), (*It)->GetActorLocation().Z);
-        Writer->WriteValue(TEXT("pitch"), (*It)->GetActorRotation().Pitch);
-        Writer->WriteValue(TEXT("yaw"), (*It)->GetActorRotation().Yaw);
+        FAdhocServerPawn& Pawn = Pawns.AddDefaulted_GetRef();
+        Pawn.UUID = AdhocPawn->GetUUID();
+        Pawn.Name = AdhocPawn->GetFriendlyName();
+        Pawn.Description = AdhocPawn->GetDescription();
+        Pawn.Location = (*It)->GetActorLocation();
+        Pawn.Rotation = (*It)->GetActorRotation();
 
         const AController* Controller = (*It)->GetController();
         const UAdhocControllerComponent* AdhocController = Controller
             ? Cast<UAdhocControllerComponent>(Controller->GetComponentByClass(UAdhocControllerComponent::StaticClass()))
             : nullptr;
 
-        if (AdhocController && AdhocController->GetUserID() != -1)
-        {
-            Writer->WriteValue(TEXT("userId"), AdhocController->GetUserID());
-        }
-        else
+        if (AdhocController)
         {
-            Writer->WriteNull(TEXT("userId"));
+            Pawn.UserID = AdhocController->GetUserID();
         }
 
-        Writer->WriteValue(TEXT("human"), AdhocPawn->IsHuman());
+        Pawn.bHuman = AdhocPawn->IsHuman();
 
         if (AdhocPawn->GetFactionIndex() != -1)
         {
-            const FAdhocFactionState& Faction = AdhocGameState->GetFaction(AdhocPawn->GetFactionIndex());
-            Writer->WriteValue(TEXT("factionId"), Faction.ID);
-        }
-        else
-        {
-            Writer->WriteNull(TEXT("factionId"));
+            Pawn.FactionID = AdhocGameState->GetFaction(AdhocPawn->GetFactionIndex()).ID;
         }
-
-        Writer->WriteObjectEnd();
-
-        PawnIndex++;
     }
 
-    Writer->WriteArrayEnd();
-
-    Writer->WriteObjectEnd();
-    Writer->Close();
+    FString JsonString;
+    FAdhocManagerJson::WriteServerPawns(AdhocGameState->GetServerID(), Pawns, JsonString);
 
-    UE_LOG(LogAdhocGameModeComponent, Verbose, TEXT("Sending: %s"), *JsonString);
-    StompClient->Send("/app/ServerPawns", JsonString);
+    ADHOC_LOG_BODY(LogAdhocGameModeComponent, Verbose, JsonString, TEXT("Sending:"));
+    SendStompMessage(TEXT("/app/ServerPawns"), JsonString);
 }
 
 #endif
@@ -20,6 +20,7 @@
 
 #include "Game/AdhocGameStateComponent.h"
 
+#include "Diagnostics/AdhocProfiler.h"
 #include "Net/UnrealNetwork.h"
 
 UAdhocGameStateComponent::UAdhocGameStateComponent(const FObjectInitializer& ObjectInitializer)
@@ -48,16 +49,49 @@ void UAdhocGameStateComponent::SetFactions(const TArray<FAdhocFactionState>& New
     Factions += NewFactions;
 }
 
+void UAdhocGameStateComponent::AddFaction(const FAdhocFactionState& NewFaction)
+{
+    // factions are looked up by index so they must stay at their index
+    if (!ensure(NewFaction.Index >= 0))
+    {
+        return;
+    }
+    if (NewFaction.Index >= Factions.Num())
+    {
+        Factions.SetNum(NewFaction.Index + 1);
+    }
+    Factions[NewFaction.Index] = NewFaction;
+}
+
 void UAdhocGameStateComponent::SetObjectives(const TArray<FAdhocObjectiveState>& NewObjectives)
 {
     Objectives.Empty();
     Objectives += NewObjectives;
 }
 
+void UAdhocGameStateComponent::SetActiveAreaIndexes(const TArray<int32>& NewActiveAreaIndexes)
+{
+    ActiveAreaIndexes = NewActiveAreaIndexes;
+    UpdateActiveAreaBounds();
+}
+
 void UAdhocGameStateComponent::SetAreas(const TArray<FAdhocAreaState>& NewAreas)
 {
     Areas.Empty();
     Areas += NewAreas;
+    UpdateActiveAreaBounds();
+}
+
+void UAdhocGameStateComponent::UpdateActiveAreaBounds()
+{
+    ActiveAreaBounds.Reset();
+    for (const FAdhocAreaState& Area : Areas)
+    {
+        if (Area.RegionID == RegionID && ActiveAreaIndexes.Contains(Area.Index))
+        {
+            ActiveAreaBounds.Add(FBox::BuildAABB(Area.Location, Area.Size * 0.5));
+        }
+    }
 }
 
 void UAdhocGameStateComponent::SetServers(const TArray<FAdhocServerState>& NewServers)
@@ -154,7 +188,7 @@ FAdhocServerState* UAdhocGameStateComponent::FindServerByID(const int64 InServer
 {
     for (int i = 0; i < Servers.Num(); i++)
     {
-        if (Servers[i].ID == ServerID)
+        if (Servers[i].ID == InServerID)
         {
             return &Servers[i];
         }
@@ -187,6 +221,124 @@ FAdhocServerState* UAdhocGameStateComponent::FindOrInsertServerByID(const int64
     return &Servers.Add_GetRef(NewServer);
 }
 
+void UAdhocGameStateComponent::IndexStructure(const FGuid& UUID)
+{
+    const FAdhocStructureState* Structure = Structures.Find(UUID);
+    if (!Structure)
+    {
+        Structure = PendingStructures.Find(UUID);
+    }
+
+    if (Structure)
+    {
+        StructureSpatialHash.Update(UUID, Structure->Location);
+    }
+    else
+    {
+        StructureSpatialHash.Remove(UUID);
+    }
+}
+
+void UAdhocGameStateComponent::AddStructure(const FAdhocStructureState& Structure)
+{
+    Structures.Add(Structure.UUID, Structure);
+    StructureSpatialHash.Update(Structure.UUID, Structure.Location);
+}
+
+void UAdhocGameStateComponent::AddPendingStructure(const FAdhocStructureState& Structure)
+{
+    PendingStructures.Add(Structure.UUID, Structure);
+    StructureSpatialHash.Update(Structure.UUID, Structure.Location);
+}
+
+bool UAdhocGameStateComponent::RemovePendingStructure(const FGuid& UUID, FAdhocStructureState& OutStructure)
+{
+    return PendingStructures.RemoveAndCopyValue(UUID, OutStructure);
+}
+
+void UAdhocGameStateComponent::FindStructuresInBox(const FBox& Box, TArray<const FAdhocStructureState*>& OutStructures) const
+{
+    ADHOC_SCOPE(FindStructuresInBox);
+
+    TArray<FGuid> UUIDs;
+    StructureSpatialHash.FindInBox(Box, UUIDs);
+
+    for (const FGuid& UUID : UUIDs)
+    {
+        const FAdhocStructureState* Structure = Structures.Find(UUID);
+        if (!Structure)
+        {
+            Structure = PendingStructures.Find(UUID);
+        }
+        if (Structure && Box.IsInsideOrOn(Structure->Location))
+        {
+            OutStructures.Add(Structure);
+        }
+    }
+}
+
+int32 UAdhocGameStateComponent::FindAreaIndexByLocation(const FVector& Location) const
+{
+    ADHOC_SCOPE(FindAreaIndexByLocation);
+
+    for (const FAdhocAreaState& Area : Areas)
+    {
+        if (Area.RegionID == RegionID && FBox::BuildAABB(Area.Location, Area.Size * 0.5).IsInsideOrOn(Location))
+        {
+            return Area.Index;
+        }
+    }
+    return -1;
+}
+
+bool UAdhocGameStateComponent::IsLocationNearActiveAreas(const FVector& Location, const float Margin) const
+{
+    ADHOC_SCOPE(IsLocationNearActiveAreas);
+
+    const double MarginSquared = FMath::Square(static_cast<double>(FMath::Max(0.0f, Margin)));
+    for (const FBox& Bounds : ActiveAreaBounds)
+    {
+        if (Bounds.ComputeSquaredDistanceToPoint(Location) <= MarginSquared)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void UAdhocGameStateComponent::FindAreaIndexesNearActiveAreas(const float Margin, TArray<int32>& OutAreaIndexes) const
+{
+    OutAreaIndexes.Reset();
+    for (const int32 AreaIndex : ActiveAreaIndexes)
+    {
+        OutAreaIndexes.AddUnique(AreaIndex);
+    }
+
+    for (const FAdhocAreaState& Area : Areas)
+    {
+        if (Area.RegionID != RegionID)
+        {
+            continue;
+        }
+
+        if (Margin < 0)
+        {
+            OutAreaIndexes.AddUnique(Area.Index);
+            continue;
+        }
+
+        const FBox ExpandedBounds = FBox::BuildAABB(Area.Location, Area.Size * 0.5).ExpandBy(Margin);
+        for (const FBox& Bounds : ActiveAreaBounds)
+        {
+            if (ExpandedBounds.Intersect(Bounds))
+            {
+                OutAreaIndexes.AddUnique(Area.Index);
+                break;
+            }
+        }
+    }
+}
+
 FColor UAdhocGameStateComponent::GetFactionColorSafe(int32 FactionIndex) const
 {
     if (FactionIndex >= 0 && FactionIndex < Factions.Num())
@@ -229,6 +381,8 @@ FColor UAdhocGameStateComponent::GetFactionColorSafe(int32 FactionIndex) const
 
 bool UAdhocGameStateComponent::IsObjectiveActiveAndTakeableByFaction(const int32 ObjectiveIndex, const int32 FactionIndex)
 {
+    ADHOC_SCOPE(IsObjectiveActiveAndTakeableByFaction);
+
     const FAdhocObjectiveState* Objective = FindObjectiveByIndex(ObjectiveIndex);
 
     return Objective
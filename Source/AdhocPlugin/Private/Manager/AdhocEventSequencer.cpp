@@ -0,0 +1,160 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Manager/AdhocEventSequencer.h"
+
+#include "Dom/JsonObject.h"
+
+void FAdhocEventSequencer::Receive(const FName StreamName, const int64 Sequence, const TSharedPtr<FJsonObject>& Event, const double Now,
+    const TFunctionRef<void(const TSharedPtr<FJsonObject>&)> Apply, const TFunctionRef<void(FName)> OnGap)
+{
+    FStream& Stream = Streams.FindOrAdd(StreamName);
+    Stream.Stats.NumReceived++;
+
+    if (Stream.NextSequence < 0)
+    {
+        Stream.NextSequence = Sequence;
+    }
+
+    if (Sequence < Stream.NextSequence || Stream.Held.Contains(Sequence))
+    {
+        Stream.Stats.NumDuplicates++;
+        return;
+    }
+
+    if (Sequence > Stream.NextSequence)
+    {
+        Stream.Held.Add(Sequence, FHeldEvent{Event, Now});
+        NumHeldEvents++;
+        Stream.Stats.NumReordered++;
+        Stream.Stats.ReorderDepth = Stream.Held.Num();
+        Stream.Stats.MaxReorderDepth = FMath::Max(Stream.Stats.MaxReorderDepth, Stream.Stats.ReorderDepth);
+
+        if (Stream.Held.Num() > MaxReorderDepth)
+        {
+            SkipGap(StreamName, Stream, Apply, OnGap);
+        }
+        return;
+    }
+
+    Stream.NextSequence++;
+    Apply(Event);
+    ApplyHeld(Stream, Apply);
+}
+
+void FAdhocEventSequencer::Seed(const FName StreamName, const int64 NextSequence, const TFunctionRef<void(const TSharedPtr<FJsonObject>&)> Apply)
+{
+    FStream& Stream = Streams.FindOrAdd(StreamName);
+    if (NextSequence <= Stream.NextSequence)
+    {
+        return;
+    }
+
+    Stream.NextSequence = NextSequence;
+
+    // anything held from before the snapshot is already reflected in it
+    while (Stream.Held.Num() > 0)
+    {
+        const int64 FirstHeldSequence = Stream.Held.CreateConstIterator().Key();
+        if (FirstHeldSequence >= NextSequence)
+        {
+            break;
+        }
+        Stream.Held.Remove(FirstHeldSequence);
+        NumHeldEvents--;
+        Stream.Stats.NumDuplicates++;
+    }
+
+    ApplyHeld(Stream, Apply);
+}
+
+void FAdhocEventSequencer::Flush(const double Now, const TFunctionRef<void(const TSharedPtr<FJsonObject>&)> Apply, const TFunctionRef<void(FName)> OnGap)
+{
+    if (NumHeldEvents == 0)
+    {
+        return;
+    }
+
+    for (TPair<FName, FStream>& StreamPair : Streams)
+    {
+        FStream& Stream = StreamPair.Value;
+        while (Stream.Held.Num() > 0)
+        {
+            double OldestReceivedTime = Now;
+            for (const TPair<int64, FHeldEvent>& HeldPair : Stream.Held)
+            {
+                OldestReceivedTime = FMath::Min(OldestReceivedTime, HeldPair.Value.ReceivedTime);
+            }
+            if (Now - OldestReceivedTime <= MaxReorderWaitSeconds)
+            {
+                break;
+            }
+            SkipGap(StreamPair.Key, Stream, Apply, OnGap);
+        }
+    }
+}
+
+void FAdhocEventSequencer::ApplyHeld(FStream& Stream, const TFunctionRef<void(const TSharedPtr<FJsonObject>&)> Apply)
+{
+    FHeldEvent HeldEvent;
+    while (Stream.Held.RemoveAndCopyValue(Stream.NextSequence, HeldEvent))
+    {
+        NumHeldEvents--;
+        Stream.NextSequence++;
+        Apply(HeldEvent.Event);
+    }
+    Stream.Stats.ReorderDepth = Stream.Held.Num();
+}
+
+void FAdhocEventSequencer::SkipGap(const FName StreamName, FStream& Stream, const TFunctionRef<void(const TSharedPtr<FJsonObject>&)> Apply, const TFunctionRef<void(FName)> OnGap)
+{
+    // the held map is sorted so the first key is the earliest event we have
+    const int64 FirstHeldSequence = Stream.Held.CreateConstIterator().Key();
+
+    Stream.Stats.NumGaps++;
+    Stream.Stats.NumMissed += FirstHeldSequence - Stream.NextSequence;
+    Stream.NextSequence = FirstHeldSequence;
+
+    OnGap(StreamName);
+    ApplyHeld(Stream, Apply);
+}
+
+void FAdhocEventSequencer::GetStats(TMap<FName, FStreamStats>& OutStats) const
+{
+    for (const TPair<FName, FStream>& StreamPair : Streams)
+    {
+        OutStats.Add(StreamPair.Key, StreamPair.Value.Stats);
+    }
+}
+
+void FAdhocEventSequencer::Remove(const FName Stream)
+{
+    FStream RemovedStream;
+    if (Streams.RemoveAndCopyValue(Stream, RemovedStream))
+    {
+        NumHeldEvents -= RemovedStream.Held.Num();
+    }
+}
+
+void FAdhocEventSequencer::Reset()
+{
+    Streams.Reset();
+    NumHeldEvents = 0;
+}
@@ -0,0 +1,327 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Manager/AdhocManagerClient.h"
+
+#include "Diagnostics/AdhocBodyLog.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/Compression.h"
+
+DEFINE_LOG_CATEGORY(LogAdhocManagerClient)
+
+FAdhocManagerClient::FAdhocManagerClient(const FString& InManagerHost, const int32 InManagerPort, const FString& InAuthorizationHeaderValue)
+    : ManagerHost(InManagerHost)
+    , ManagerPort(InManagerPort)
+    , AuthorizationHeaderValue(InAuthorizationHeaderValue)
+{
+}
+
+FAdhocManagerClient::~FAdhocManagerClient()
+{
+    CancelAll();
+}
+
+void FAdhocManagerClient::Get(const FName Endpoint, const FString& Path, const FAdhocManagerResponseDelegate& OnComplete)
+{
+    const TSharedRef<FPendingRequest> PendingRequest = MakeShared<FPendingRequest>();
+    PendingRequest->Endpoint = Endpoint;
+    PendingRequest->Verb = TEXT("GET");
+    PendingRequest->URL = FString::Printf(TEXT("http://%s:%d/adhoc_api/%s"), *ManagerHost, ManagerPort, *Path);
+    PendingRequest->OnComplete = OnComplete;
+
+    Submit(PendingRequest);
+}
+
+void FAdhocManagerClient::Post(const FName Endpoint, const FString& Path, const FString& JsonContent, const FAdhocManagerResponseDelegate& OnComplete)
+{
+    const TSharedRef<FPendingRequest> PendingRequest = MakeShared<FPendingRequest>();
+    PendingRequest->Endpoint = Endpoint;
+    PendingRequest->Verb = TEXT("POST");
+    PendingRequest->URL = FString::Printf(TEXT("http://%s:%d/adhoc_api/%s"), *ManagerHost, ManagerPort, *Path);
+    PendingRequest->Content = JsonContent;
+    PendingRequest->OnComplete = OnComplete;
+
+    if (bCompressRequests)
+    {
+        const FTCHARToUTF8 Utf8Content(*JsonContent);
+        if (Utf8Content.Length() >= MinCompressRequestBytes)
+        {
+            const TArray<uint8> Uncompressed(reinterpret_cast<const uint8*>(Utf8Content.Get()), Utf8Content.Length());
+            if (!GzipCompress(Uncompressed, PendingRequest->CompressedContent))
+            {
+                UE_LOG(LogAdhocManagerClient, Warning, TEXT("Failed to compress %d bytes for %s - sending uncompressed"), Uncompressed.Num(), *PendingRequest->URL);
+                PendingRequest->CompressedContent.Reset();
+            }
+        }
+    }
+
+    Submit(PendingRequest);
+}
+
+void FAdhocManagerClient::CancelAll()
+{
+    for (const TSharedRef<FPendingRequest>& PendingRequest : ActiveRequests)
+    {
+        if (PendingRequest->RetryTickerHandle.IsValid())
+        {
+            FTSTicker::GetCoreTicker().RemoveTicker(PendingRequest->RetryTickerHandle);
+            PendingRequest->RetryTickerHandle.Reset();
+        }
+        if (PendingRequest->HttpRequest.IsValid())
+        {
+            PendingRequest->HttpRequest->OnProcessRequestComplete().Unbind();
+            PendingRequest->HttpRequest->CancelRequest();
+            PendingRequest->HttpRequest.Reset();
+        }
+    }
+
+    ActiveRequests.Reset();
+    QueuedRequests.Empty();
+    NumQueuedRequests = 0;
+    NumInFlightRequests = 0;
+}
+
+bool FAdhocManagerClient::GzipCompress(const TArray<uint8>& Uncompressed, TArray<uint8>& OutCompressed)
+{
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, Uncompressed.Num());
+    OutCompressed.SetNumUninitialized(CompressedSize);
+    if (!FCompression::CompressMemory(NAME_Gzip, OutCompressed.GetData(), CompressedSize, Uncompressed.GetData(), Uncompressed.Num()))
+    {
+        return false;
+    }
+
+    OutCompressed.SetNum(CompressedSize);
+    return true;
+}
+
+bool FAdhocManagerClient::GzipUncompress(const TArray<uint8>& Compressed, TArray<uint8>& OutUncompressed)
+{
+    // 10 byte header + 8 byte trailer at minimum
+    if (Compressed.Num() < 18 || Compressed[0] != 0x1f || Compressed[1] != 0x8b)
+    {
+        return false;
+    }
+
+    // ISIZE (uncompressed size modulo 2^32) is the last 4 bytes, little endian
+    const int32 TrailerIndex = Compressed.Num() - 4;
+    const uint32 UncompressedSize = Compressed[TrailerIndex] | Compressed[TrailerIndex + 1] << 8 | Compressed[TrailerIndex + 2] << 16 | Compressed[TrailerIndex + 3] << 24;
+
+    // guard against a bogus trailer - manager responses are nowhere near this
+    static constexpr uint32 MaxUncompressedSize = 256 * 1024 * 1024;
+    if (UncompressedSize > MaxUncompressedSize)
+    {
+        return false;
+    }
+
+    OutUncompressed.SetNumUninitialized(UncompressedSize);
+    return FCompression::UncompressMemory(NAME_Gzip, OutUncompressed.GetData(), UncompressedSize, Compressed.GetData(), Compressed.Num());
+}
+
+void FAdhocManagerClient::LogLatencySummary() const
+{
+    for (const TPair<FName, FAdhocLatencyHistogram>& LatencyHistogram : LatencyHistograms)
+    {
+        const FAdhocLatencyHistogram& Histogram = LatencyHistogram.Value;
+
+        UE_LOG(LogAdhocManagerClient, Log, TEXT("Latency: Endpoint=%s Count=%lld Mean=%.1fms P50=%.0fms P90=%.0fms P99=%.0fms Max=%.1fms"),
+            *LatencyHistogram.Key.ToString(), Histogram.Count, Histogram.Count > 0 ? Histogram.SumMs / Histogram.Count : 0.0,
+            Histogram.GetPercentileMs(0.5), Histogram.GetPercentileMs(0.9), Histogram.GetPercentileMs(0.99), Histogram.MaxMs);
+    }
+}
+
+const FAdhocManagerEndpointSettings& FAdhocManagerClient::GetEndpointSettings(const FName Endpoint) const
+{
+    const FAdhocManagerEndpointSettings* Settings = EndpointSettings.Find(Endpoint);
+    return Settings ? *Settings : DefaultEndpointSettings;
+}
+
+void FAdhocManagerClient::Submit(const TSharedRef<FPendingRequest>& PendingRequest)
+{
+    if (bOffline)
+    {
+        UE_LOG(LogAdhocManagerClient, Verbose, TEXT("Offline - dropping %s %s"), *PendingRequest->Verb, *PendingRequest->URL);
+        FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_manager_requests_dropped_total"), FAdhocMetrics::Label(TEXT("endpoint"), PendingRequest->Endpoint.ToString()));
+        return;
+    }
+
+    PendingRequest->SubmitTime = FPlatformTime::Seconds();
+
+    Enqueue(PendingRequest);
+    SendQueuedRequests();
+}
+
+void FAdhocManagerClient::Enqueue(const TSharedRef<FPendingRequest>& PendingRequest)
+{
+    QueuedRequests.Enqueue(PendingRequest);
+    NumQueuedRequests++;
+}
+
+void FAdhocManagerClient::SendQueuedRequests()
+{
+    TSharedPtr<FPendingRequest> PendingRequest;
+    while (NumInFlightRequests < MaxInFlightRequests && QueuedRequests.Dequeue(PendingRequest))
+    {
+        NumQueuedRequests--;
+
+        Send(PendingRequest.ToSharedRef());
+    }
+}
+
+void FAdhocManagerClient::Send(const TSharedRef<FPendingRequest>& PendingRequest)
+{
+    const FAdhocManagerEndpointSettings& Settings = GetEndpointSettings(PendingRequest->Endpoint);
+
+    PendingRequest->Attempts++;
+
+    const FHttpRequestRef HttpRequest = FHttpModule::Get().CreateRequest();
+    HttpRequest->OnProcessRequestComplete().BindSP(AsShared(), &FAdhocManagerClient::OnHttpRequestComplete, PendingRequest);
+    HttpRequest->SetURL(PendingRequest->URL);
+    HttpRequest->SetVerb(PendingRequest->Verb);
+    HttpRequest->SetTimeout(Settings.TimeoutSeconds);
+    HttpRequest->SetHeader(TEXT("Authorization"), AuthorizationHeaderValue);
+    if (bAcceptCompressedResponses)
+    {
+        HttpRequest->SetHeader(TEXT("Accept-Encoding"), TEXT("gzip"));
+    }
+    if (PendingRequest->Verb == TEXT("POST"))
+    {
+        HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+        if (PendingRequest->CompressedContent.Num() > 0)
+        {
+            HttpRequest->SetHeader(TEXT("Content-Encoding"), TEXT("gzip"));
+            HttpRequest->SetContent(PendingRequest->CompressedContent);
+        }
+        else
+        {
+            HttpRequest->SetContentAsString(PendingRequest->Content);
+        }
+    }
+
+    PendingRequest->HttpRequest = HttpRequest;
+    ActiveRequests.AddUnique(PendingRequest);
+    NumInFlightRequests++;
+
+    const FString EndpointLabel = FAdhocMetrics::Label(TEXT("endpoint"), PendingRequest->Endpoint.ToString());
+    FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_manager_requests_sent_total"), EndpointLabel);
+    FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_manager_request_bytes_total"), EndpointLabel, HttpRequest->GetContentLength());
+    if (PendingRequest->Attempts > 1)
+    {
+        FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_manager_request_retries_total"), EndpointLabel);
+    }
+
+    ADHOC_LOG_BODY(LogAdhocManagerClient, Verbose, PendingRequest->Content, TEXT("%s %s (attempt %d):"), *PendingRequest->Verb, *PendingRequest->URL, PendingRequest->Attempts);
+    HttpRequest->ProcessRequest();
+}
+
+void FAdhocManagerClient::OnHttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, const bool bWasSuccessful, TSharedRef<FPendingRequest> PendingRequest)
+{
+    NumInFlightRequests = FMath::Max(0, NumInFlightRequests - 1);
+    PendingRequest->HttpRequest.Reset();
+
+    const FAdhocManagerEndpointSettings& Settings = GetEndpointSettings(PendingRequest->Endpoint);
+
+    const int32 ResponseCode = bWasSuccessful && HttpResponse.IsValid() ? HttpResponse->GetResponseCode() : 0;
+    const bool bRetryable = (PendingRequest->Verb == TEXT("GET") || Settings.bIdempotent) && (ResponseCode == 0 || ResponseCode == 429 || ResponseCode >= 500);
+
+    if (bRetryable && PendingRequest->Attempts <= Settings.MaxRetries)
+    {
+        // exponential backoff with +/- 50% jitter
+        const float RetryDelay = Settings.RetryDelaySeconds * FMath::Pow(2.0f, PendingRequest->Attempts - 1) * FMath::FRandRange(0.5f, 1.5f);
+
+        UE_LOG(LogAdhocManagerClient, Warning, TEXT("%s %s failed (attempt %d): ResponseCode=%d - retrying in %.2f seconds"),
+            *PendingRequest->Verb, *PendingRequest->URL, PendingRequest->Attempts, ResponseCode, RetryDelay);
+
+        PendingRequest->RetryTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateSP(AsShared(), &FAdhocManagerClient::OnRetryTicker, PendingRequest), RetryDelay);
+    }
+    else
+    {
+        Complete(PendingRequest, bWasSuccessful ? HttpResponse : FHttpResponsePtr());
+    }
+
+    SendQueuedRequests();
+}
+
+bool FAdhocManagerClient::OnRetryTicker(float DeltaTime, TSharedRef<FPendingRequest> PendingRequest)
+{
+    PendingRequest->RetryTickerHandle.Reset();
+
+    // retries go to the back of the queue so they respect the in flight limit like everything else
+    Enqueue(PendingRequest);
+    SendQueuedRequests();
+
+    return false;
+}
+
+FString FAdhocManagerClient::GetResponseContent(const FHttpResponsePtr& HttpResponse) const
+{
+    // the HTTP backend may have already decoded the content for us (in which case there will be no gzip header)
+    const TArray<uint8>& RawContent = HttpResponse->GetContent();
+    if (!bAcceptCompressedResponses || !HttpResponse->GetHeader(TEXT("Content-Encoding")).Equals(TEXT("gzip"), ESearchCase::IgnoreCase)
+        || RawContent.Num() < 2 || RawContent[0] != 0x1f || RawContent[1] != 0x8b)
+    {
+        return HttpResponse->GetContentAsString();
+    }
+
+    TArray<uint8> Uncompressed;
+    if (!GzipUncompress(RawContent, Uncompressed))
+    {
+        UE_LOG(LogAdhocManagerClient, Warning, TEXT("Failed to uncompress %d byte gzip response from %s"), RawContent.Num(), *HttpResponse->GetURL());
+        return FString();
+    }
+
+    UE_LOG(LogAdhocManagerClient, VeryVerbose, TEXT("Uncompressed response from %s: %d -> %d bytes"), *HttpResponse->GetURL(), RawContent.Num(), Uncompressed.Num());
+
+    const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Uncompressed.GetData()), Uncompressed.Num());
+    return FString(Converted.Length(), Converted.Get());
+}
+
+void FAdhocManagerClient::Complete(const TSharedRef<FPendingRequest>& PendingRequest, const FHttpResponsePtr& HttpResponse)
+{
+    ActiveRequests.Remove(PendingRequest);
+
+    FAdhocManagerResponse Response;
+    Response.bReceived = HttpResponse.IsValid();
+    Response.ResponseCode = HttpResponse.IsValid() ? HttpResponse->GetResponseCode() : 0;
+    if (HttpResponse.IsValid())
+    {
+        Response.Content = GetResponseContent(HttpResponse);
+    }
+    Response.Attempts = PendingRequest->Attempts;
+    Response.Latency = FPlatformTime::Seconds() - PendingRequest->SubmitTime;
+
+    LatencyHistograms.FindOrAdd(PendingRequest->Endpoint).Add(Response.Latency * 1000);
+
+    const FString EndpointLabel = FAdhocMetrics::Label(TEXT("endpoint"), PendingRequest->Endpoint.ToString());
+    FAdhocMetrics::Get().ObserveHistogram(TEXT("adhoc_manager_request_latency_seconds"), EndpointLabel, Response.Latency * 1000);
+    FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_manager_responses_total"),
+        EndpointLabel + TEXT(",") + FAdhocMetrics::Label(TEXT("code"), FString::FromInt(Response.ResponseCode)));
+    if (HttpResponse.IsValid())
+    {
+        FAdhocMetrics::Get().IncrementCounter(TEXT("adhoc_manager_response_bytes_total"), EndpointLabel, HttpResponse->GetContentLength());
+    }
+
+    UE_LOG(LogAdhocManagerClient, Verbose, TEXT("%s %s completed: ResponseCode=%d Attempts=%d Latency=%.1fms"),
+        *PendingRequest->Verb, *PendingRequest->URL, Response.ResponseCode, Response.Attempts, Response.Latency * 1000);
+
+    OnRequestCompleted.ExecuteIfBound(PendingRequest->Endpoint, FString::Printf(TEXT("%s %s"), *PendingRequest->Verb, *PendingRequest->URL), Response);
+    PendingRequest->OnComplete.ExecuteIfBound(Response);
+}
@@ -0,0 +1,282 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Manager/AdhocManagerJson.h"
+
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+void FAdhocManagerJson::WriteAreas(const TArray<FAdhocAreaState>& Areas, FString& OutJson)
+{
+    const auto& Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutJson);
+
+    Writer->WriteArrayStart();
+    for (const FAdhocAreaState& AreaState : Areas)
+    {
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("regionId"), AreaState.RegionID);
+        Writer->WriteValue(TEXT("index"), AreaState.Index);
+        Writer->WriteValue(TEXT("name"), AreaState.Name);
+        Writer->WriteValue(TEXT("x"), static_cast<double>(AreaState.Location.X));
+        Writer->WriteValue(TEXT("y"), static_cast<double>(-AreaState.Location.Y));
+        Writer->WriteValue(TEXT("z"), static_cast<double>(AreaState.Location.Z));
+        Writer->WriteValue(TEXT("sizeX"), static_cast<double>(AreaState.Size.X));
+        Writer->WriteValue(TEXT("sizeY"), static_cast<double>(AreaState.Size.Y));
+        Writer->WriteValue(TEXT("sizeZ"), static_cast<double>(AreaState.Size.Z));
+        // Writer->WriteNull(TEXT("serverId"));
+        Writer->WriteObjectEnd();
+    }
+    Writer->WriteArrayEnd();
+
+    Writer->Close();
+}
+
+void FAdhocManagerJson::WriteObjectives(const int64 RegionID, const TArray<FAdhocObjectiveState>& Objectives, FString& OutJson)
+{
+    const auto& Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutJson);
+
+    Writer->WriteArrayStart();
+    for (const FAdhocObjectiveState& Objective : Objectives)
+    {
+        const FVector Size = FVector(1, 1, 1); // ObjectiveActor->GetActorScale() * 200; // TODO
+
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("regionId"), RegionID);
+        Writer->WriteValue(TEXT("index"), Objective.Index);
+        Writer->WriteValue(TEXT("name"), Objective.Name);
+        Writer->WriteValue(TEXT("x"), static_cast<double>(Objective.Location.X));
+        Writer->WriteValue(TEXT("y"), static_cast<double>(-Objective.Location.Y));
+        Writer->WriteValue(TEXT("z"), static_cast<double>(Objective.Location.Z));
+        Writer->WriteValue(TEXT("sizeX"), static_cast<double>(Size.X));
+        Writer->WriteValue(TEXT("sizeY"), static_cast<double>(Size.Y));
+        Writer->WriteValue(TEXT("sizeZ"), static_cast<double>(Size.Z));
+
+        if (Objective.InitialFactionIndex == -1)
+        {
+            Writer->WriteNull(TEXT("initialFactionIndex"));
+        }
+        else
+        {
+            Writer->WriteValue(TEXT("initialFactionIndex"), static_cast<double>(Objective.InitialFactionIndex));
+        }
+
+        Writer->WriteArrayStart(TEXT("linkedObjectiveIndexes"));
+        for (const int32 LinkedObjectiveIndex : Objective.LinkedObjectiveIndexes)
+        {
+            Writer->WriteValue(LinkedObjectiveIndex);
+        }
+        Writer->WriteArrayEnd();
+
+        // Writer->WriteValue(FString("areaId"), ObjectiveActor->GetAreaVolume()->GetAreaID());
+        Writer->WriteValue(TEXT("areaIndex"), Objective.AreaIndex);
+
+        Writer->WriteObjectEnd();
+    }
+    Writer->WriteArrayEnd();
+
+    Writer->Close();
+}
+
+void FAdhocManagerJson::WriteServerPawns(const int64 ServerID, const TArray<FAdhocServerPawn>& Pawns, FString& OutJson)
+{
+    const auto& Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutJson);
+
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("eventType"), TEXT("ServerPawns"));
+    Writer->WriteValue(TEXT("serverId"), ServerID);
+
+    Writer->WriteArrayStart(TEXT("pawns"));
+
+    for (int32 PawnIndex = 0; PawnIndex < Pawns.Num(); PawnIndex++)
+    {
+        const FAdhocServerPawn& Pawn = Pawns[PawnIndex];
+
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("uuid"), Pawn.UUID.ToString(EGuidFormats::DigitsWithHyphens));
+        Writer->WriteValue(TEXT("name"), Pawn.Name);
+        Writer->WriteValue(TEXT("description"), Pawn.Description);
+        Writer->WriteValue(TEXT("serverId"), ServerID);
+        Writer->WriteValue(TEXT("index"), PawnIndex);
+
+        Writer->WriteValue(TEXT("x"), Pawn.Location.X);
+        Writer->WriteValue(TEXT("y"), -Pawn.Location.Y);
+        Writer->WriteValue(TEXT("z"), Pawn.Location.Z);
+        Writer->WriteValue(TEXT("pitch"), Pawn.Rotation.Pitch);
+        Writer->WriteValue(TEXT("yaw"), Pawn.Rotation.Yaw);
+
+        if (Pawn.UserID != -1)
+        {
+            Writer->WriteValue(TEXT("userId"), Pawn.UserID);
+        }
+        else
+        {
+            Writer->WriteNull(TEXT("userId"));
+        }
+
+        Writer->WriteValue(TEXT("human"), Pawn.bHuman);
+
+        if (Pawn.FactionID != -1)
+        {
+            Writer->WriteValue(TEXT("factionId"), Pawn.FactionID);
+        }
+        else
+        {
+            Writer->WriteNull(TEXT("factionId"));
+        }
+
+        Writer->WriteObjectEnd();
+    }
+
+    Writer->WriteArrayEnd();
+
+    Writer->WriteObjectEnd();
+    Writer->Close();
+}
+
+bool FAdhocManagerJson::ParseFactions(const FStringView Json, TArray<FAdhocFactionState>& OutFactions)
+{
+    const auto& Reader = TJsonReaderFactory<>::CreateFromView(Json);
+    TArray<TSharedPtr<FJsonValue>> JsonValues;
+    if (!FJsonSerializer::Deserialize(Reader, JsonValues))
+    {
+        return false;
+    }
+
+    OutFactions.SetNum(JsonValues.Num());
+
+    for (int i = 0; i < JsonValues.Num(); i++)
+    {
+        const TSharedPtr<FJsonObject> JsonObject = JsonValues[i]->AsObject();
+        OutFactions[i].ID = JsonObject->GetIntegerField("id");
+        JsonObject->TryGetNumberField("version", OutFactions[i].Version);
+        OutFactions[i].Index = JsonObject->GetIntegerField("index");
+        OutFactions[i].Name = JsonObject->GetStringField("name");
+        OutFactions[i].Color = FColor::FromHex(JsonObject->GetStringField("color"));
+        OutFactions[i].Score = JsonObject->GetIntegerField("score");
+    }
+
+    return true;
+}
+
+bool FAdhocManagerJson::ParseServers(const FStringView Json, TArray<FAdhocServerState>& OutServers)
+{
+    const auto& Reader = TJsonReaderFactory<>::CreateFromView(Json);
+    TArray<TSharedPtr<FJsonValue>> JsonValues;
+    if (!FJsonSerializer::Deserialize(Reader, JsonValues))
+    {
+        return false;
+    }
+
+    OutServers.SetNum(JsonValues.Num());
+
+    for (int i = 0; i < OutServers.Num(); i++)
+    {
+        const TSharedPtr<FJsonObject> JsonObject = JsonValues[i]->AsObject();
+
+        OutServers[i].ID = JsonObject->GetIntegerField("id");
+        JsonObject->TryGetNumberField("version", OutServers[i].Version);
+        // OutServers[i].Name = JsonObject->GetStringField("name");
+        // OutServers[i].HostingType = NewServer->GetStringField("hostingType");
+        // OutServers[i].Status = JsonObject->GetStringField("status");
+        OutServers[i].bEnabled = JsonObject->GetBoolField("enabled");
+        OutServers[i].bActive = JsonObject->GetBoolField("active");
+        JsonObject->TryGetStringField("privateIP", OutServers[i].PrivateIP);
+        JsonObject->TryGetStringField("publicIP", OutServers[i].PublicIP);
+        JsonObject->TryGetNumberField("publicWebSocketPort", OutServers[i].PublicWebSocketPort);
+        OutServers[i].RegionID = JsonObject->GetIntegerField("regionId");
+        for (auto& AreaIDValue : JsonObject->GetArrayField("areaIds"))
+        {
+            OutServers[i].AreaIDs.AddUnique(AreaIDValue->AsNumber());
+        }
+        for (auto& AreaIndexValue : JsonObject->GetArrayField("areaIndexes"))
+        {
+            OutServers[i].AreaIndexes.AddUnique(AreaIndexValue->AsNumber());
+        }
+    }
+
+    return true;
+}
+
+bool FAdhocManagerJson::ParseAreas(const FStringView Json, TArray<FAdhocAreaState>& OutAreas)
+{
+    const auto& Reader = TJsonReaderFactory<>::CreateFromView(Json);
+    TArray<TSharedPtr<FJsonValue>> JsonValues;
+    if (!FJsonSerializer::Deserialize(Reader, JsonValues))
+    {
+        return false;
+    }
+
+    OutAreas.SetNum(JsonValues.Num());
+
+    for (int i = 0; i < OutAreas.Num(); i++)
+    {
+        const TSharedPtr<FJsonObject> JsonObject = JsonValues[i]->AsObject();
+
+        OutAreas[i].ID = JsonObject->GetIntegerField("id");
+        JsonObject->TryGetNumberField("version", OutAreas[i].Version);
+        OutAreas[i].RegionID = JsonObject->GetIntegerField("regionId");
+        OutAreas[i].Index = JsonObject->GetIntegerField("index");
+        OutAreas[i].Name = JsonObject->GetStringField("name");
+        JsonObject->TryGetNumberField("serverId", OutAreas[i].ServerID);
+    }
+
+    return true;
+}
+
+bool FAdhocManagerJson::ParseObjectives(const FStringView Json, TArray<FAdhocObjectiveState>& OutObjectives)
+{
+    const auto& Reader = TJsonReaderFactory<>::CreateFromView(Json);
+    TArray<TSharedPtr<FJsonValue>> JsonValues;
+    if (!FJsonSerializer::Deserialize(Reader, JsonValues))
+    {
+        return false;
+    }
+
+    OutObjectives.SetNum(JsonValues.Num());
+
+    for (int i = 0; i < OutObjectives.Num(); i++)
+    {
+        const TSharedPtr<FJsonObject> JsonObject = JsonValues[i]->AsObject();
+        OutObjectives[i].ID = JsonObject->GetIntegerField("id");
+        JsonObject->TryGetNumberField("version", OutObjectives[i].Version);
+        OutObjectives[i].Name = JsonObject->GetStringField("name");
+        OutObjectives[i].RegionID = JsonObject->GetIntegerField("regionId");
+        OutObjectives[i].Index = JsonObject->GetIntegerField("index");
+        JsonObject->TryGetNumberField(TEXT("initialFactionId"), OutObjectives[i].InitialFactionID);
+        JsonObject->TryGetNumberField(TEXT("initialFactionIndex"), OutObjectives[i].InitialFactionIndex);
+        JsonObject->TryGetNumberField(TEXT("factionId"), OutObjectives[i].FactionID);
+        JsonObject->TryGetNumberField(TEXT("factionIndex"), OutObjectives[i].FactionIndex);
+        JsonObject->TryGetNumberField(TEXT("areaId"), OutObjectives[i].AreaID);
+        JsonObject->TryGetNumberField(TEXT("areaIndex"), OutObjectives[i].AreaIndex);
+
+        for (auto& LinkedObjectiveID : JsonObject->GetArrayField("linkedObjectiveIds"))
+        {
+            OutObjectives[i].LinkedObjectiveIDs.AddUnique(LinkedObjectiveID->AsNumber());
+        }
+        for (auto& LinkedObjectiveIndex : JsonObject->GetArrayField("linkedObjectiveIndexes"))
+        {
+            OutObjectives[i].LinkedObjectiveIndexes.AddUnique(LinkedObjectiveIndex->AsNumber());
+        }
+    }
+
+    return true;
+}
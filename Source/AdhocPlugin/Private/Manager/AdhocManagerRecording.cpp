@@ -0,0 +1,317 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Manager/AdhocManagerRecording.h"
+
+#include "HAL/FileManager.h"
+#include "Manager/AdhocManagerClient.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY(LogAdhocManagerRecording)
+
+namespace AdhocManagerRecording
+{
+    /** Strings are written as length prefixed UTF-8 - bodies are (mostly ASCII) JSON so this is much more compact than an FString, which falls back to UTF-16 for any non-ANSI character. */
+    static void WriteString(FArchive& Ar, const FString& String)
+    {
+        const FTCHARToUTF8 Utf8String(*String);
+        int32 Length = Utf8String.Length();
+        Ar << Length;
+        Ar.Serialize(const_cast<ANSICHAR*>(Utf8String.Get()), Length);
+    }
+
+    static bool ReadString(FArchive& Ar, FString& OutString)
+    {
+        int32 Length = 0;
+        Ar << Length;
+        if (Ar.IsError() || Length < 0 || Length > Ar.TotalSize() - Ar.Tell())
+        {
+            Ar.SetError();
+            return false;
+        }
+
+        TArray<ANSICHAR> Utf8String;
+        Utf8String.SetNumUninitialized(Length);
+        Ar.Serialize(Utf8String.GetData(), Length);
+
+        const FUTF8ToTCHAR String(Utf8String.GetData(), Length);
+        OutString = FString(String.Length(), String.Get());
+        return true;
+    }
+
+    /** Replace the user token in a user join / navigate response (returns false if the body is not a JSON object, in which case it should not be recorded). */
+    static bool RedactUserToken(FString& Body)
+    {
+        const auto& Reader = TJsonReaderFactory<>::Create(Body);
+        TSharedPtr<FJsonObject> JsonObject;
+        if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+        {
+            return false;
+        }
+
+        if (JsonObject->HasField(TEXT("token")))
+        {
+            JsonObject->SetStringField(TEXT("token"), TEXT("REDACTED"));
+
+            FString RedactedBody;
+            const auto& Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&RedactedBody);
+            FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+            Body = MoveTemp(RedactedBody);
+        }
+
+        return true;
+    }
+
+    static void WriteRecord(FArchive& Ar, const FAdhocManagerRecord& Record)
+    {
+        uint8 Kind = static_cast<uint8>(Record.Kind);
+        int64 Ticks = Record.Timestamp.GetTicks();
+        uint8 bReceived = Record.bReceived ? 1 : 0;
+        int32 ResponseCode = Record.ResponseCode;
+        int32 Attempts = Record.Attempts;
+        double Latency = Record.Latency;
+
+        Ar << Kind << Ticks << bReceived << ResponseCode << Attempts << Latency;
+        WriteString(Ar, Record.Name);
+        WriteString(Ar, Record.Request);
+        WriteString(Ar, Record.Body);
+    }
+
+    static bool ReadRecord(FArchive& Ar, FAdhocManagerRecord& OutRecord)
+    {
+        uint8 Kind = 0;
+        int64 Ticks = 0;
+        uint8 bReceived = 0;
+
+        Ar << Kind << Ticks << bReceived << OutRecord.ResponseCode << OutRecord.Attempts << OutRecord.Latency;
+        if (Ar.IsError() || Kind > static_cast<uint8>(EAdhocManagerRecordKind::Response))
+        {
+            return false;
+        }
+
+        OutRecord.Kind = static_cast<EAdhocManagerRecordKind>(Kind);
+        OutRecord.Timestamp = FDateTime(Ticks);
+        OutRecord.bReceived = bReceived != 0;
+
+        return ReadString(Ar, OutRecord.Name) && ReadString(Ar, OutRecord.Request) && ReadString(Ar, OutRecord.Body);
+    }
+}
+
+FAdhocManagerRecorder::~FAdhocManagerRecorder()
+{
+    Close();
+}
+
+bool FAdhocManagerRecorder::Open(const FString& InFilePath)
+{
+    Close();
+
+    if (IFileManager::Get().FileSize(*InFilePath) > 0)
+    {
+        TArray<uint8> FileBytes;
+        TArray<FAdhocManagerRecord> ExistingRecords;
+        int64 ValidSize = 0;
+        if (!FFileHelper::LoadFileToArray(FileBytes, *InFilePath) || !Parse(InFilePath, FileBytes, ExistingRecords, ValidSize))
+        {
+            UE_LOG(LogAdhocManagerRecording, Error, TEXT("Not appending to %s as it is not a recording of this version - remove it or record to another file"), *InFilePath);
+            return false;
+        }
+
+        if (ValidSize < FileBytes.Num())
+        {
+            UE_LOG(LogAdhocManagerRecording, Warning, TEXT("Truncating %s to its last complete record before appending: Records=%d Size=%lld OldSize=%d"),
+                *InFilePath, ExistingRecords.Num(), ValidSize, FileBytes.Num());
+
+            FileBytes.SetNum(ValidSize);
+            if (!FFileHelper::SaveArrayToFile(FileBytes, *InFilePath))
+            {
+                UE_LOG(LogAdhocManagerRecording, Error, TEXT("Failed to truncate %s for recording"), *InFilePath);
+                return false;
+            }
+        }
+    }
+
+    Writer.Reset(IFileManager::Get().CreateFileWriter(*InFilePath, FILEWRITE_Append | FILEWRITE_AllowRead));
+    if (!Writer)
+    {
+        UE_LOG(LogAdhocManagerRecording, Error, TEXT("Failed to open %s for recording"), *InFilePath);
+        return false;
+    }
+
+    FilePath = InFilePath;
+    NumRecords = 0;
+    LastFlushTime = FPlatformTime::Seconds();
+
+    if (Writer->TotalSize() == 0)
+    {
+        uint32 FileMagic = Magic;
+        uint32 FileVersion = Version;
+        *Writer << FileMagic;
+        *Writer << FileVersion;
+    }
+
+    UE_LOG(LogAdhocManagerRecording, Log, TEXT("Recording manager messages to %s"), *FPaths::ConvertRelativePathToFull(FilePath));
+    return true;
+}
+
+void FAdhocManagerRecorder::Close()
+{
+    if (!Writer)
+    {
+        return;
+    }
+
+    Writer->Close();
+    Writer.Reset();
+
+    UE_LOG(LogAdhocManagerRecording, Log, TEXT("Recorded %lld manager messages to %s"), NumRecords, *FilePath);
+}
+
+void FAdhocManagerRecorder::RecordStompEvent(const FString& Destination, const FString& Body)
+{
+    FAdhocManagerRecord Record;
+    Record.Kind = EAdhocManagerRecordKind::StompEvent;
+    Record.Timestamp = FDateTime::UtcNow();
+    Record.Name = Destination;
+    Record.bReceived = true;
+    Record.Body = Body;
+
+    this->Record(Record);
+}
+
+void FAdhocManagerRecorder::RecordResponse(const FName Endpoint, const FString& Request, const FAdhocManagerResponse& Response)
+{
+    // the key user tokens are signed with would let anyone holding the recording forge tokens
+    if (Endpoint == TEXT("userTokenKey"))
+    {
+        return;
+    }
+
+    FAdhocManagerRecord Record;
+    Record.Kind = EAdhocManagerRecordKind::Response;
+    Record.Timestamp = FDateTime::UtcNow();
+    Record.Name = Endpoint.ToString();
+    Record.Request = Request;
+    Record.bReceived = Response.bReceived;
+    Record.ResponseCode = Response.ResponseCode;
+    Record.Attempts = Response.Attempts;
+    Record.Latency = Response.Latency;
+    Record.Body = Response.Content;
+
+    if ((Endpoint == TEXT("userJoin") || Endpoint == TEXT("userNavigate")) && !Record.Body.IsEmpty() && !AdhocManagerRecording::RedactUserToken(Record.Body))
+    {
+        Record.Body.Reset();
+    }
+
+    this->Record(Record);
+}
+
+void FAdhocManagerRecorder::Record(const FAdhocManagerRecord& Record)
+{
+    if (!Writer)
+    {
+        return;
+    }
+
+    RecordBytes.Reset();
+    FMemoryWriter RecordWriter(RecordBytes);
+    AdhocManagerRecording::WriteRecord(RecordWriter, Record);
+
+    int32 RecordSize = RecordBytes.Num();
+    *Writer << RecordSize;
+    Writer->Serialize(RecordBytes.GetData(), RecordSize);
+    NumRecords++;
+
+    const double Now = FPlatformTime::Seconds();
+    if (Now - LastFlushTime >= 1)
+    {
+        Writer->Flush();
+        LastFlushTime = Now;
+    }
+}
+
+bool FAdhocManagerRecorder::Load(const FString& FilePath, TArray<FAdhocManagerRecord>& OutRecords)
+{
+    TArray<uint8> FileBytes;
+    if (!FFileHelper::LoadFileToArray(FileBytes, *FilePath))
+    {
+        UE_LOG(LogAdhocManagerRecording, Error, TEXT("Failed to read recording %s"), *FilePath);
+        return false;
+    }
+
+    int64 ValidSize = 0;
+    if (!Parse(FilePath, FileBytes, OutRecords, ValidSize))
+    {
+        return false;
+    }
+
+    UE_LOG(LogAdhocManagerRecording, Log, TEXT("Loaded %d manager messages from %s"), OutRecords.Num(), *FilePath);
+    return true;
+}
+
+bool FAdhocManagerRecorder::Parse(const FString& FilePath, const TArray<uint8>& FileBytes, TArray<FAdhocManagerRecord>& OutRecords, int64& OutValidSize)
+{
+    FMemoryReader Reader(FileBytes);
+
+    uint32 FileMagic = 0;
+    uint32 FileVersion = 0;
+    Reader << FileMagic;
+    Reader << FileVersion;
+    if (Reader.IsError() || FileMagic != Magic || FileVersion != Version)
+    {
+        UE_LOG(LogAdhocManagerRecording, Error, TEXT("%s is not a recording (or is an unsupported version): Magic=%08x Version=%u"), *FilePath, FileMagic, FileVersion);
+        return false;
+    }
+    OutValidSize = Reader.Tell();
+
+    while (Reader.TotalSize() - Reader.Tell() >= static_cast<int64>(sizeof(int32)))
+    {
+        int32 RecordSize = 0;
+        Reader << RecordSize;
+
+        const int64 RecordStart = Reader.Tell();
+        if (RecordSize < 0 || RecordSize > Reader.TotalSize() - RecordStart)
+        {
+            UE_LOG(LogAdhocManagerRecording, Warning, TEXT("%s ends with an incomplete record (recording was probably cut short) - ignoring it"), *FilePath);
+            break;
+        }
+
+        FAdhocManagerRecord& Record = OutRecords.AddDefaulted_GetRef();
+        if (!AdhocManagerRecording::ReadRecord(Reader, Record) || Reader.Tell() > RecordStart + RecordSize)
+        {
+            UE_LOG(LogAdhocManagerRecording, Warning, TEXT("%s has a corrupt record at offset %lld - ignoring the rest of the file"), *FilePath, RecordStart);
+            OutRecords.Pop();
+            break;
+        }
+
+        // skip anything a later version may have added to the record
+        Reader.Seek(RecordStart + RecordSize);
+        OutValidSize = Reader.Tell();
+    }
+
+    return true;
+}
@@ -0,0 +1,102 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Structure/AdhocStructureSpatialHash.h"
+
+FAdhocStructureSpatialHash::FAdhocStructureSpatialHash(const float InCellSize)
+    : CellSize(FMath::Max(1.0f, InCellSize))
+{
+}
+
+void FAdhocStructureSpatialHash::Update(const FGuid& UUID, const FVector& Location)
+{
+    const FIntVector Cell = GetCell(Location);
+
+    if (FIntVector* ExistingCell = CellsByUUID.Find(UUID))
+    {
+        if (*ExistingCell == Cell)
+        {
+            return;
+        }
+
+        Remove(UUID);
+    }
+
+    Cells.FindOrAdd(Cell).Add(UUID);
+    CellsByUUID.Add(UUID, Cell);
+}
+
+void FAdhocStructureSpatialHash::Remove(const FGuid& UUID)
+{
+    FIntVector Cell;
+    if (!CellsByUUID.RemoveAndCopyValue(UUID, Cell))
+    {
+        return;
+    }
+
+    if (TArray<FGuid>* CellUUIDs = Cells.Find(Cell))
+    {
+        CellUUIDs->RemoveSwap(UUID);
+        if (CellUUIDs->Num() == 0)
+        {
+            Cells.Remove(Cell);
+        }
+    }
+}
+
+void FAdhocStructureSpatialHash::Reset()
+{
+    Cells.Reset();
+    CellsByUUID.Reset();
+}
+
+void FAdhocStructureSpatialHash::FindInBox(const FBox& Box, TArray<FGuid>& OutUUIDs) const
+{
+    const FIntVector MinCell = GetCell(Box.Min);
+    const FIntVector MaxCell = GetCell(Box.Max);
+
+    // a huge box would visit far more (mostly empty) cells than there are occupied ones
+    const int64 NumBoxCells = static_cast<int64>(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1) * (MaxCell.Z - MinCell.Z + 1);
+    if (NumBoxCells > Cells.Num())
+    {
+        for (const TPair<FIntVector, TArray<FGuid>>& Cell : Cells)
+        {
+            if (Cell.Key.X >= MinCell.X && Cell.Key.X <= MaxCell.X && Cell.Key.Y >= MinCell.Y && Cell.Key.Y <= MaxCell.Y && Cell.Key.Z >= MinCell.Z && Cell.Key.Z <= MaxCell.Z)
+            {
+                OutUUIDs.Append(Cell.Value);
+            }
+        }
+        return;
+    }
+
+    for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+        {
+            for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+            {
+                if (const TArray<FGuid>* CellUUIDs = Cells.Find(FIntVector(X, Y, Z)))
+                {
+                    OutUUIDs.Append(*CellUUIDs);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,112 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Manager/AdhocEventSequencer.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAdhocEventSequencerTest, "Adhoc.Manager.EventSequencer",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FAdhocEventSequencerTest::RunTest(const FString& Parameters)
+{
+    FAdhocEventSequencer Sequencer;
+    Sequencer.MaxReorderDepth = 2;
+    Sequencer.MaxReorderWaitSeconds = 1.0f;
+
+    TArray<int64> Applied;
+    TArray<FName> Gaps;
+    const auto Apply = [&Applied](const TSharedPtr<FJsonObject>& Event) { Applied.Add(static_cast<int64>(Event->GetNumberField(TEXT("sequence")))); };
+    const auto OnGap = [&Gaps](const FName Stream) { Gaps.Add(Stream); };
+    const auto Receive = [&](const FName Stream, const int64 Sequence, const double Now)
+    {
+        const TSharedPtr<FJsonObject> Event = MakeShared<FJsonObject>();
+        Event->SetNumberField(TEXT("sequence"), Sequence);
+        Sequencer.Receive(Stream, Sequence, Event, Now, Apply, OnGap);
+    };
+
+    // seeded from a snapshot at version 10 - earlier events are already covered and later ones are put back in order
+    Sequencer.Seed(TEXT("servers"), 11, Apply);
+    Receive(TEXT("servers"), 10, 0);
+    Receive(TEXT("servers"), 12, 0);
+    TestEqual(TEXT("Held until the missing event arrives"), Applied.Num(), 0);
+    TestTrue(TEXT("Has held events"), Sequencer.HasHeldEvents());
+    Receive(TEXT("servers"), 11, 0);
+    TestEqual(TEXT("Applied in order"), Applied, TArray<int64>({11, 12}));
+    TestFalse(TEXT("No held events"), Sequencer.HasHeldEvents());
+
+    // a later snapshot covering held events drops them and releases what follows
+    Applied.Reset();
+    Receive(TEXT("servers"), 14, 0);
+    Receive(TEXT("servers"), 15, 0);
+    Sequencer.Seed(TEXT("servers"), 15, Apply);
+    TestEqual(TEXT("Seed releases held events after the snapshot"), Applied, TArray<int64>({15}));
+    Sequencer.Seed(TEXT("servers"), 5, Apply);
+    Receive(TEXT("servers"), 16, 0);
+    TestEqual(TEXT("Seed never moves a stream backwards"), Applied, TArray<int64>({15, 16}));
+
+    // streams are independent and (if never seeded) start from their first event
+    Applied.Reset();
+    Receive(TEXT("objectives"), 100, 0);
+    TestEqual(TEXT("Unseeded stream starts at first event"), Applied, TArray<int64>({100}));
+
+    // too many held events skips the gap
+    Applied.Reset();
+    Receive(TEXT("objectives"), 102, 0);
+    Receive(TEXT("objectives"), 103, 0);
+    TestEqual(TEXT("Held within reorder depth"), Applied.Num(), 0);
+    Receive(TEXT("objectives"), 104, 0);
+    TestEqual(TEXT("Gap skipped when reorder depth exceeded"), Applied, TArray<int64>({102, 103, 104}));
+    TestEqual(TEXT("Gap reported"), Gaps, TArray<FName>({TEXT("objectives")}));
+
+    // events held too long skip the gap on flush
+    Applied.Reset();
+    Gaps.Reset();
+    Receive(TEXT("objectives"), 106, 10);
+    Sequencer.Flush(10.5, Apply, OnGap);
+    TestEqual(TEXT("Not flushed before the wait"), Applied.Num(), 0);
+    Sequencer.Flush(11.5, Apply, OnGap);
+    TestEqual(TEXT("Flushed after the wait"), Applied, TArray<int64>({106}));
+    TestEqual(TEXT("Gap reported on flush"), Gaps.Num(), 1);
+
+    TMap<FName, FAdhocEventSequencer::FStreamStats> Stats;
+    Sequencer.GetStats(Stats);
+    TestEqual(TEXT("Servers duplicates (before seed and dropped by seed)"), Stats.FindRef(TEXT("servers")).NumDuplicates, static_cast<int64>(2));
+    TestEqual(TEXT("Objectives gaps"), Stats.FindRef(TEXT("objectives")).NumGaps, static_cast<int64>(2));
+    TestEqual(TEXT("Objectives missed"), Stats.FindRef(TEXT("objectives")).NumMissed, static_cast<int64>(2));
+
+    // a removed stream (e.g. an unsubscribed area topic) starts afresh rather than seeing a gap
+    Applied.Reset();
+    Gaps.Reset();
+    Receive(TEXT("objectives"), 110, 20);
+    TestTrue(TEXT("Held before removal"), Sequencer.HasHeldEvents());
+    Sequencer.Remove(TEXT("objectives"));
+    TestFalse(TEXT("Held events dropped on removal"), Sequencer.HasHeldEvents());
+    Receive(TEXT("objectives"), 200, 20);
+    TestEqual(TEXT("Removed stream starts at its next event"), Applied, TArray<int64>({200}));
+    TestEqual(TEXT("No gap after removal"), Gaps.Num(), 0);
+
+    return true;
+}
+
+#endif
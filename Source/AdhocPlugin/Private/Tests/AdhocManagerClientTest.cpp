@@ -0,0 +1,62 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Manager/AdhocManagerClient.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAdhocManagerClientGzipTest, "Adhoc.Manager.Client.Gzip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FAdhocManagerClientGzipTest::RunTest(const FString& Parameters)
+{
+    FString JsonString = TEXT("[");
+    for (int32 Index = 0; Index < 1000; Index++)
+    {
+        JsonString += FString::Printf(TEXT("%s{\"index\":%d,\"name\":\"Objective %d\"}"), Index > 0 ? TEXT(",") : TEXT(""), Index, Index);
+    }
+    JsonString += TEXT("]");
+
+    const FTCHARToUTF8 Utf8Json(*JsonString);
+    const TArray<uint8> Uncompressed(reinterpret_cast<const uint8*>(Utf8Json.Get()), Utf8Json.Length());
+
+    TArray<uint8> Compressed;
+    if (!TestTrue(TEXT("Compress"), FAdhocManagerClient::GzipCompress(Uncompressed, Compressed)))
+    {
+        return false;
+    }
+    TestTrue(TEXT("Compressed is smaller"), Compressed.Num() < Uncompressed.Num());
+    TestTrue(TEXT("Compressed has gzip header"), Compressed.Num() >= 2 && Compressed[0] == 0x1f && Compressed[1] == 0x8b);
+
+    TArray<uint8> Roundtrip;
+    TestTrue(TEXT("Uncompress"), FAdhocManagerClient::GzipUncompress(Compressed, Roundtrip));
+    TestTrue(TEXT("Roundtrip matches"), Roundtrip == Uncompressed);
+
+    TestFalse(TEXT("Uncompress rejects data without a gzip header"), FAdhocManagerClient::GzipUncompress(Uncompressed, Roundtrip));
+
+    const TArray<uint8> Truncated(Compressed.GetData(), Compressed.Num() / 2);
+    TestFalse(TEXT("Uncompress rejects truncated data"), FAdhocManagerClient::GzipUncompress(Truncated, Roundtrip));
+
+    return true;
+}
+
+#endif
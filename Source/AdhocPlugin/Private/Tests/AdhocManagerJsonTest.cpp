@@ -0,0 +1,149 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Manager/AdhocManagerJson.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAdhocManagerJsonParseTest, "Adhoc.Manager.Json.Parse",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FAdhocManagerJsonParseTest::RunTest(const FString& Parameters)
+{
+    TArray<FAdhocFactionState> Factions;
+    if (TestTrue(TEXT("Parse factions"), FAdhocManagerJson::ParseFactions(
+        TEXT(R"([{"id":1,"version":7,"index":0,"name":"Team Alpha","color":"#0088FF","score":3},{"id":2,"index":1,"name":"Team Beta","color":"#FF2200","score":0}])"), Factions)))
+    {
+        TestEqual(TEXT("Faction count"), Factions.Num(), 2);
+        TestEqual(TEXT("Faction ID"), Factions[0].ID, static_cast<int64>(1));
+        TestEqual(TEXT("Faction version"), Factions[0].Version, static_cast<int64>(7));
+        TestEqual(TEXT("Faction without version"), Factions[1].Version, static_cast<int64>(-1));
+        TestEqual(TEXT("Faction index"), Factions[1].Index, 1);
+        TestEqual(TEXT("Faction name"), Factions[0].Name, FString(TEXT("Team Alpha")));
+        TestTrue(TEXT("Faction color"), Factions[0].Color == FColor(0x00, 0x88, 0xFF));
+        TestEqual(TEXT("Faction score"), Factions[0].Score, 3.0f);
+    }
+
+    TArray<FAdhocServerState> Servers;
+    if (TestTrue(TEXT("Parse servers"), FAdhocManagerJson::ParseServers(
+        TEXT(R"([{"id":5,"version":2,"regionId":1,"enabled":true,"active":false,"privateIP":"10.0.0.5","publicIP":"1.2.3.4","publicWebSocketPort":8889,"areaIds":[10,11,11],"areaIndexes":[0,1]}])"), Servers)))
+    {
+        TestEqual(TEXT("Server count"), Servers.Num(), 1);
+        TestEqual(TEXT("Server ID"), Servers[0].ID, static_cast<int64>(5));
+        TestEqual(TEXT("Server version"), Servers[0].Version, static_cast<int64>(2));
+        TestTrue(TEXT("Server enabled"), Servers[0].bEnabled);
+        TestFalse(TEXT("Server active"), Servers[0].bActive);
+        TestEqual(TEXT("Server public IP"), Servers[0].PublicIP, FString(TEXT("1.2.3.4")));
+        TestEqual(TEXT("Server port"), Servers[0].PublicWebSocketPort, 8889);
+        TestEqual(TEXT("Server area IDs (unique)"), Servers[0].AreaIDs.Num(), 2);
+        TestTrue(TEXT("Server area indexes"), Servers[0].AreaIndexes == TArray<int32>({0, 1}));
+    }
+
+    TArray<FAdhocAreaState> Areas;
+    if (TestTrue(TEXT("Parse areas"), FAdhocManagerJson::ParseAreas(TEXT(R"([{"id":10,"regionId":1,"index":0,"name":"A","serverId":5},{"id":11,"regionId":1,"index":1,"name":"B"}])"), Areas)))
+    {
+        TestEqual(TEXT("Area count"), Areas.Num(), 2);
+        TestEqual(TEXT("Area server ID"), Areas[0].ServerID, static_cast<int64>(5));
+        TestEqual(TEXT("Area without server ID"), Areas[1].ServerID, static_cast<int64>(-1));
+    }
+
+    TArray<FAdhocObjectiveState> Objectives;
+    if (TestTrue(TEXT("Parse objectives"), FAdhocManagerJson::ParseObjectives(
+        TEXT(R"([{"id":20,"version":4,"name":"Alpha","regionId":1,"index":0,"initialFactionId":1,"initialFactionIndex":0,"factionId":2,"factionIndex":1,"areaId":10,"areaIndex":0,"linkedObjectiveIds":[21],"linkedObjectiveIndexes":[1]}])"), Objectives)))
+    {
+        TestEqual(TEXT("Objective count"), Objectives.Num(), 1);
+        TestEqual(TEXT("Objective version"), Objectives[0].Version, static_cast<int64>(4));
+        TestEqual(TEXT("Objective faction ID"), Objectives[0].FactionID, static_cast<int64>(2));
+        TestEqual(TEXT("Objective faction index"), Objectives[0].FactionIndex, 1);
+        TestEqual(TEXT("Objective area index"), Objectives[0].AreaIndex, 0);
+        TestEqual(TEXT("Objective linked IDs"), Objectives[0].LinkedObjectiveIDs.Num(), 1);
+        TestTrue(TEXT("Objective linked indexes"), Objectives[0].LinkedObjectiveIndexes == TArray<int32>({1}));
+    }
+
+    TestFalse(TEXT("Parse rejects invalid JSON"), FAdhocManagerJson::ParseServers(TEXT("[{\"id\":"), Servers));
+    TestFalse(TEXT("Parse rejects an object where an array is expected"), FAdhocManagerJson::ParseFactions(TEXT("{\"error\":\"unavailable\"}"), Factions));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAdhocManagerJsonWriteTest, "Adhoc.Manager.Json.Write",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FAdhocManagerJsonWriteTest::RunTest(const FString& Parameters)
+{
+    TArray<FAdhocObjectiveState> Objectives;
+    FAdhocObjectiveState& Objective = Objectives.AddDefaulted_GetRef();
+    Objective.Index = 3;
+    Objective.Name = TEXT("Alpha \"Point\"");
+    Objective.Location = FVector(100, 200, 300);
+    Objective.LinkedObjectiveIndexes = {1, 2};
+    Objective.AreaIndex = 0;
+
+    FString Json;
+    FAdhocManagerJson::WriteObjectives(7, Objectives, Json);
+
+    TArray<TSharedPtr<FJsonValue>> JsonValues;
+    if (!TestTrue(TEXT("Objectives are valid JSON"), FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), JsonValues)) || !TestEqual(TEXT("Objective count"), JsonValues.Num(), 1))
+    {
+        return false;
+    }
+
+    const TSharedPtr<FJsonObject> JsonObject = JsonValues[0]->AsObject();
+    TestEqual(TEXT("Region ID"), JsonObject->GetIntegerField(TEXT("regionId")), 7);
+    TestEqual(TEXT("Index"), JsonObject->GetIntegerField(TEXT("index")), 3);
+    TestEqual(TEXT("Name is escaped"), JsonObject->GetStringField(TEXT("name")), Objective.Name);
+    TestEqual(TEXT("Y is flipped for the manager"), JsonObject->GetNumberField(TEXT("y")), -200.0);
+    TestTrue(TEXT("Unknown initial faction is null"), JsonObject->HasTypedField<EJson::Null>(TEXT("initialFactionIndex")));
+    TestEqual(TEXT("Linked objective indexes"), JsonObject->GetArrayField(TEXT("linkedObjectiveIndexes")).Num(), 2);
+
+    TArray<FAdhocServerPawn> Pawns;
+    FAdhocServerPawn& Pawn = Pawns.AddDefaulted_GetRef();
+    Pawn.UUID = FGuid::NewGuid();
+    Pawn.Name = TEXT("Bot1");
+    Pawn.bHuman = false;
+    Pawn.FactionID = 2;
+
+    Json.Reset();
+    FAdhocManagerJson::WriteServerPawns(5, Pawns, Json);
+
+    TSharedPtr<FJsonObject> PawnsObject;
+    if (!TestTrue(TEXT("Server pawns are valid JSON"), FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), PawnsObject)))
+    {
+        return false;
+    }
+    TestEqual(TEXT("Event type"), PawnsObject->GetStringField(TEXT("eventType")), FString(TEXT("ServerPawns")));
+    const TArray<TSharedPtr<FJsonValue>>& PawnValues = PawnsObject->GetArrayField(TEXT("pawns"));
+    if (TestEqual(TEXT("Pawn count"), PawnValues.Num(), 1))
+    {
+        const TSharedPtr<FJsonObject> PawnObject = PawnValues[0]->AsObject();
+        TestEqual(TEXT("Pawn UUID"), PawnObject->GetStringField(TEXT("uuid")), Pawn.UUID.ToString(EGuidFormats::DigitsWithHyphens));
+        TestTrue(TEXT("Unknown user is null"), PawnObject->HasTypedField<EJson::Null>(TEXT("userId")));
+        TestEqual(TEXT("Faction ID"), PawnObject->GetIntegerField(TEXT("factionId")), 2);
+    }
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,124 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Manager/AdhocManagerRecording.h"
+
+#include "HAL/FileManager.h"
+#include "Manager/AdhocManagerClient.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAdhocManagerRecordingTest, "Adhoc.Manager.Recording",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FAdhocManagerRecordingTest::RunTest(const FString& Parameters)
+{
+    const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AdhocManagerRecordingTest.rec"));
+    IFileManager::Get().Delete(*FilePath);
+
+    FAdhocManagerRecorder Recorder;
+    if (!TestTrue(TEXT("Open"), Recorder.Open(FilePath)))
+    {
+        return false;
+    }
+
+    Recorder.RecordStompEvent(TEXT("/topic/events"), TEXT("{\"eventType\":\"ObjectiveTaken\",\"version\":3}"));
+
+    FAdhocManagerResponse Response;
+    Response.bReceived = true;
+    Response.ResponseCode = 200;
+    Response.Attempts = 1;
+    Response.Latency = 0.05;
+
+    Response.Content = TEXT("{\"key\":\"c2VjcmV0\"}");
+    Recorder.RecordResponse(TEXT("userTokenKey"), TEXT("GET /adhoc_api/servers/1/userTokenKey"), Response);
+
+    Response.Content = TEXT("{\"id\":7,\"name\":\"Anon\",\"token\":\"secret-token\"}");
+    Recorder.RecordResponse(TEXT("userJoin"), TEXT("POST /adhoc_api/servers/1/userJoin"), Response);
+
+    Response.Content = TEXT("[{\"id\":1,\"index\":0}]");
+    Recorder.RecordResponse(TEXT("factions"), TEXT("GET /adhoc_api/servers/1/factions"), Response);
+
+    TestEqual(TEXT("User token key is not recorded"), Recorder.GetNumRecords(), static_cast<int64>(3));
+    Recorder.Close();
+
+    TArray<FAdhocManagerRecord> Records;
+    if (!TestTrue(TEXT("Load"), FAdhocManagerRecorder::Load(FilePath, Records)) || !TestEqual(TEXT("Record count"), Records.Num(), 3))
+    {
+        return false;
+    }
+
+    TestTrue(TEXT("STOMP event kind"), Records[0].Kind == EAdhocManagerRecordKind::StompEvent);
+    TestEqual(TEXT("STOMP event destination"), Records[0].Name, FString(TEXT("/topic/events")));
+    TestTrue(TEXT("Response kind"), Records[1].Kind == EAdhocManagerRecordKind::Response);
+    TestEqual(TEXT("Response endpoint"), Records[1].Name, FString(TEXT("userJoin")));
+    TestFalse(TEXT("User token is redacted"), Records[1].Body.Contains(TEXT("secret-token")));
+    TestTrue(TEXT("Rest of the user join response is kept"), Records[1].Body.Contains(TEXT("Anon")));
+    TestEqual(TEXT("Response body"), Records[2].Body, Response.Content);
+    TestEqual(TEXT("Response code"), Records[2].ResponseCode, 200);
+
+    // a recording cut short (e.g. by a crash) is read up to its last complete record
+    TArray<uint8> FileBytes;
+    if (!TestTrue(TEXT("Read recording"), FFileHelper::LoadFileToArray(FileBytes, *FilePath)))
+    {
+        return false;
+    }
+    FileBytes.SetNum(FileBytes.Num() - 5);
+    FFileHelper::SaveArrayToFile(FileBytes, *FilePath);
+
+    AddExpectedError(TEXT("incomplete record"), EAutomationExpectedErrorFlags::Contains, 1);
+
+    Records.Reset();
+    if (TestTrue(TEXT("Load truncated"), FAdhocManagerRecorder::Load(FilePath, Records)))
+    {
+        TestEqual(TEXT("Truncated record count"), Records.Num(), 2);
+    }
+
+    // appending to it first drops the incomplete record so the new session can be loaded too
+    AddExpectedError(TEXT("incomplete record"), EAutomationExpectedErrorFlags::Contains, 1);
+    AddExpectedError(TEXT("Truncating"), EAutomationExpectedErrorFlags::Contains, 1);
+
+    if (TestTrue(TEXT("Open truncated"), Recorder.Open(FilePath)))
+    {
+        Recorder.RecordStompEvent(TEXT("/topic/events"), TEXT("{\"eventType\":\"ServerUpdated\",\"version\":4}"));
+        Recorder.Close();
+
+        Records.Reset();
+        if (TestTrue(TEXT("Load appended"), FAdhocManagerRecorder::Load(FilePath, Records)))
+        {
+            TestEqual(TEXT("Appended record count"), Records.Num(), 3);
+        }
+    }
+
+    // a file which is not a recording is never appended to
+    FFileHelper::SaveStringToFile(TEXT("not a recording"), *FilePath);
+    AddExpectedError(TEXT("is not a recording"), EAutomationExpectedErrorFlags::Contains, 1);
+    AddExpectedError(TEXT("Not appending"), EAutomationExpectedErrorFlags::Contains, 1);
+    TestFalse(TEXT("Open refuses a file which is not a recording"), Recorder.Open(FilePath));
+
+    IFileManager::Get().Delete(*FilePath);
+
+    return true;
+}
+
+#endif
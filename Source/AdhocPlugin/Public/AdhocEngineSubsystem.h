@@ -22,14 +22,35 @@
 
 #include "Subsystems/EngineSubsystem.h"
 #include "Engine/World.h"
+#include "UObject/ObjectKey.h"
 
 #include "AdhocEngineSubsystem.generated.h"
 
+/** Which Adhoc component (if any) an actor needs. */
+enum class EAdhocActorComponentKind : uint8
+{
+    None,
+    Pawn,
+    PlayerController,
+    AIController,
+    PlayerState,
+    GameState,
+    Area,
+    Objective,
+    GameMode
+};
+
 UCLASS(Transient)
 class ADHOCPLUGIN_API UAdhocEngineSubsystem : public UEngineSubsystem
 {
     GENERATED_BODY()
 
+    /** Decision per actor class so repeated spawns of a class (e.g. projectiles) cost a single lookup. Keyed by FObjectKey so unloaded classes are never confused with new ones. */
+    mutable TMap<FObjectKey, EAdhocActorComponentKind> ActorClassComponentKinds;
+
+    /** Work out which existing actors need components in parallel (creating the components afterwards on the game thread) when a world is initialized. */
+    bool bParallelWorldActorInitialization = false;
+
     virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 
     void OnPostWorldCreation(UWorld* World) const;
@@ -39,6 +60,15 @@ class ADHOCPLUGIN_API UAdhocEngineSubsystem : public UEngineSubsystem
     void OnWorldBeginPlay(UWorld* World) const;
 
     void OnActorPreSpawnInitialization(AActor* Actor) const;
+    /** bCheckInstanceTags should be true for actors loaded with the level (their tags may differ from their class defaults). */
+    void InitializeActor(AActor* Actor, bool bCheckInstanceTags) const;
+    EAdhocActorComponentKind GetActorClassComponentKind(const UClass* ActorClass) const;
+    static EAdhocActorComponentKind ClassifyActorClass(const UClass* ActorClass);
+    static EAdhocActorComponentKind ApplyInstanceTags(const AActor* Actor, EAdhocActorComponentKind ClassKind);
+    static UClass* GetComponentClass(EAdhocActorComponentKind Kind);
+    /** Component class the actor still needs (or null). Read only so it is safe to call in parallel. */
+    static UClass* GetMissingComponentClass(const AActor* Actor, EAdhocActorComponentKind Kind);
+    static void AddComponent(AActor* Actor, UClass* ComponentClass);
     void OnActorSpawned(AActor* Actor) const;
 
     void OnGameModeInitialized(AGameModeBase* GameMode) const;
@@ -0,0 +1,49 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Logging/LogMacros.h"
+
+/** Log a (potentially large) message body with a formatted prefix e.g.
+ * ADHOC_LOG_BODY(LogAdhocGameModeComponent, Verbose, Response.Content, TEXT("Factions response: ResponseCode=%d"), Response.ResponseCode).
+ * The body is only truncated / copied when the category and verbosity are active, and only 1 in Adhoc.BodyLog.SampleEvery bodies is logged. */
+#define ADHOC_LOG_BODY(CategoryName, Verbosity, Body, Format, ...) \
+    do \
+    { \
+        if (UE_LOG_ACTIVE(CategoryName, Verbosity) && FAdhocBodyLog::ShouldSample()) \
+        { \
+            UE_LOG(CategoryName, Verbosity, Format TEXT(" Body=%s"), ##__VA_ARGS__, *FAdhocBodyLog::Truncate(Body)); \
+        } \
+    } \
+    while (false)
+
+/** Keeps logged message bodies (manager responses, STOMP events etc.) to a readable size. Bodies are converted to a string once by the caller
+ * and the same string is shared between logging and parsing - these helpers never convert or copy unless the result is actually logged. */
+class ADHOCPLUGIN_API FAdhocBodyLog
+{
+public:
+    /** Body limited to Adhoc.BodyLog.MaxChars (0 = no limit) with a note of how much was cut off. */
+    static FString Truncate(FStringView Body);
+
+    /** True for 1 in every Adhoc.BodyLog.SampleEvery calls (always true when that is 1 or less). Use for verbose logging only - never for failures. */
+    static bool ShouldSample();
+};
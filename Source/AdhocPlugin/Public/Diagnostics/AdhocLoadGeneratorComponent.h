@@ -0,0 +1,146 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+
+#include "AdhocLoadGeneratorComponent.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogAdhocLoadGenerator, Log, All)
+
+/** Drives the full Adhoc event loop for load testing (e.g. headless against the local mock manager). Added to the game mode when LoadGenerator=true.
+ * Spawns bots (which join via the usual AI controller path), moves their pawns between objectives, triggers objective captures / defeats / emissions
+ * at the configured rates and records frame times and bytes sent to the manager. */
+UCLASS(Transient)
+class ADHOCPLUGIN_API UAdhocLoadGeneratorComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    class UAdhocGameModeComponent* AdhocGameMode;
+    UPROPERTY()
+    class UAdhocGameStateComponent* AdhocGameState;
+
+    /** Number of bots to spawn (the game mode's default pawn class is used for their pawns). */
+    int32 NumBots = 16;
+    /** Bots spawned per second (so joins do not all hit the manager at once). */
+    float BotSpawnRate = 10;
+    /** Speed (cm/s) at which bot pawns move between waypoints. */
+    float BotSpeed = 600;
+    /** Seconds after BeginPlay before events are triggered and frame times / bytes are recorded (gives the server time to start). */
+    float Warmup = 15;
+    /** Seconds to run for after the warmup (0 to run until the server stops). */
+    float Duration = 0;
+    float CapturesPerMinute = 6;
+    float DefeatsPerMinute = 30;
+    /** Off by default as emissions need the extra module and are heavy (each one is submitted to the manager). */
+    float EmissionsPerSecond = 0;
+    /** Seconds between progress reports in the log. */
+    float ReportInterval = 10;
+    /** File to write the final report (JSON) to (empty to only log it). */
+    FString ReportFile;
+    /** Request exit once the duration has elapsed. */
+    bool bExitWhenDone = false;
+    int32 Seed = 1;
+
+    struct FBot
+    {
+        TWeakObjectPtr<class AAIController> Controller;
+        TWeakObjectPtr<class APawn> Pawn;
+        int32 WaypointIndex = -1;
+        /** Offset from the waypoint so bots heading to the same waypoint do not all end up in one spot. */
+        FVector WaypointOffset = FVector::ZeroVector;
+    };
+
+    /** Frame times bucketed at 0.1 ms (up to 1 s, beyond which they share the last bucket) so long runs use constant memory. */
+    struct FFrameTimeHistogram
+    {
+        static constexpr float BucketWidthMs = 0.1f;
+        static constexpr int32 NumBuckets = 10000;
+
+        TArray<int32> BucketCounts;
+        int32 Count = 0;
+        double SumMs = 0;
+        float MaxMs = 0;
+
+        void Add(float FrameMs);
+        void Reset();
+        /** Percentile (0-1) using the upper bound of the bucket it falls in (capped at the maximum seen). */
+        float GetPercentileMs(double Percentile) const;
+    };
+
+    TArray<FBot> Bots;
+    /** Objective locations in our active areas (or active area centres if they have no objectives). */
+    TArray<FVector> Waypoints;
+
+    FRandomStream Random;
+
+    double BeginPlayTime = 0;
+    double StartTime = -1;
+    bool bFinished = false;
+
+    double SpawnAccumulator = 0;
+    double CaptureAccumulator = 0;
+    double DefeatAccumulator = 0;
+    double EmissionAccumulator = 0;
+
+    int64 NumCaptures = 0;
+    int64 NumDefeats = 0;
+    int64 NumEmissions = 0;
+
+    /** Platform time of the previous tick (frame times are measured in wall clock time rather than using the possibly clamped delta time). */
+    double LastTickTime = 0;
+    /** Frame times since the warmup ended, plus since the last report. */
+    FFrameTimeHistogram FrameTimes;
+    FFrameTimeHistogram ReportFrameTimes;
+
+    /** Bytes sent to the manager (stomp + REST request bodies) when recording started and at the last report. */
+    double StartBytesSent = 0;
+    double ReportBytesSent = 0;
+    double ReportTime = 0;
+
+    FTimerHandle TimerHandle_Report;
+
+    explicit UAdhocLoadGeneratorComponent(const FObjectInitializer& ObjectInitializer);
+
+    virtual void InitializeComponent() override;
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+    void SpawnBot();
+    void UpdateWaypoints();
+    void MoveBots(float DeltaTime);
+
+    void TriggerCapture();
+    void TriggerDefeat();
+#if WITH_ADHOC_PLUGIN_EXTRA
+    void TriggerEmission();
+#endif
+
+    void StartRecording();
+    void Finish();
+
+    void OnTimer_Report();
+
+    static double GetBytesSent();
+    FString ReportToJson();
+};
@@ -0,0 +1,112 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogAdhocMetrics, Log, All)
+
+/** Latency histogram with fixed bucket boundaries (in milliseconds). */
+struct ADHOCPLUGIN_API FAdhocLatencyHistogram
+{
+    static constexpr int32 NumBuckets = 12;
+    /** Upper bound (inclusive) of each bucket except the last which catches everything else. */
+    static const double BucketUpperBoundsMs[NumBuckets - 1];
+
+    int64 BucketCounts[NumBuckets] = {};
+    int64 Count = 0;
+    double SumMs = 0;
+    double MaxMs = 0;
+
+    void Add(double LatencyMs);
+
+    /** Approximate percentile (0-1) using the upper bound of the bucket it falls in. */
+    double GetPercentileMs(double Percentile) const;
+};
+
+/** Registry of counters, gauges and histograms which can be exported in the Prometheus text exposition format (served on a local port and/or dumped to a file).
+ * Each metric is identified by its name plus a label string e.g. Label(TEXT("endpoint"), TEXT("factions")). Game thread only.
+ * Histograms are observed in milliseconds but exported in seconds (as Prometheus expects) so their names should end in _seconds. */
+class ADHOCPLUGIN_API FAdhocMetrics
+{
+public:
+    static FAdhocMetrics& Get();
+
+    DECLARE_MULTICAST_DELEGATE_OneParam(FOnCollect, FAdhocMetrics&);
+    /** Broadcast just before each export so owners can refresh gauges (e.g. queue sizes) rather than updating them all the time. */
+    FOnCollect OnCollect;
+
+    /** Times a scope into a histogram. */
+    class ADHOCPLUGIN_API FScopedTimer
+    {
+    public:
+        FScopedTimer(const TCHAR* InName, FString InLabels = FString());
+        ~FScopedTimer();
+
+    private:
+        const TCHAR* Name;
+        FString Labels;
+        double StartTime;
+    };
+
+    /** Formats key="value" (escaping the value as the exposition format requires). */
+    static FString Label(const TCHAR* Key, const FString& Value);
+
+    void IncrementCounter(const TCHAR* Name, const FString& Labels = FString(), double Amount = 1);
+    /** For totals which are already accumulated elsewhere (e.g. by a queue) and only copied in on collect. */
+    void SetCounter(const TCHAR* Name, const FString& Labels, double Value);
+    void SetGauge(const TCHAR* Name, const FString& Labels, double Value);
+    void ObserveHistogram(const TCHAR* Name, const FString& Labels, double ValueMs);
+
+    double GetCounter(const TCHAR* Name, const FString& Labels = FString()) const;
+    /** Sum of a counter over all of its labels. */
+    double GetCounterTotal(const TCHAR* Name) const;
+
+    FString ExportPrometheusText();
+    bool SaveToFile(const FString& FilePath);
+
+    /** Serve the export at http://BindAddress:Port/metrics (dedicated servers only). */
+    bool StartHttpExport(uint32 Port, const FString& BindAddress = TEXT("127.0.0.1"));
+    /** Stop serving the export (the route is unbound but the listener keeps running as the HTTP server module can only stop every listener at once). */
+    void StopHttpExport();
+
+    /** Forget every metric (e.g. at the start of each play in editor session, as this singleton outlives them). */
+    void Reset();
+
+private:
+    enum class EType : uint8
+    {
+        Counter,
+        Gauge,
+        Histogram
+    };
+
+    struct FFamily
+    {
+        EType Type;
+        TMap<FString, double> Values;
+        TMap<FString, FAdhocLatencyHistogram> Histograms;
+    };
+
+    TMap<FString, FFamily> Families;
+
+    FFamily& FindOrAddFamily(const TCHAR* Name, EType Type);
+};
@@ -0,0 +1,91 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_STATS_GROUP(TEXT("Adhoc"), STATGROUP_Adhoc, STATCAT_Advanced);
+
+/** Stat cycle counter, trace CPU scope and rolling profiler sample for an Adhoc hot path e.g. ADHOC_SCOPE(OnTimer_ServerPawns).
+ * The rolling profiler works without stats / trace so it can be used on headless dedicated servers ("Adhoc.Profile" console command). */
+#define ADHOC_SCOPE(Name) \
+    DECLARE_SCOPE_CYCLE_COUNTER(TEXT(#Name), STAT_Adhoc_##Name, STATGROUP_Adhoc); \
+    TRACE_CPUPROFILER_EVENT_SCOPE(Adhoc_##Name); \
+    static const FName AdhocProfilerName_##Name(TEXT(#Name)); \
+    const FAdhocProfiler::FScope AdhocProfilerScope_##Name(AdhocProfilerName_##Name)
+
+/** Per scope call counts and times over a rolling window of recent seconds (game thread only - samples from other threads are ignored). */
+class ADHOCPLUGIN_API FAdhocProfiler
+{
+public:
+    static constexpr int32 MaxWindowSeconds = 60;
+
+    static FAdhocProfiler& Get();
+
+    class ADHOCPLUGIN_API FScope
+    {
+    public:
+        explicit FScope(const FName InName)
+            : Name(InName), StartCycles(bEnabled ? FPlatformTime::Cycles64() : 0)
+        {
+        }
+
+        ~FScope()
+        {
+            if (StartCycles != 0)
+            {
+                Get().AddSample(Name, FPlatformTime::Cycles64() - StartCycles);
+            }
+        }
+
+    private:
+        FName Name;
+        uint64 StartCycles;
+    };
+
+    /** Toggled with Adhoc.Profiler.Enabled (off by default so hot paths only pay for a branch unless someone is profiling). */
+    static bool bEnabled;
+
+    void AddSample(FName Name, uint64 Cycles);
+
+    /** Log calls, total / average / max time per scope over the last WindowSeconds, most expensive first. */
+    void LogSummary(int32 WindowSeconds) const;
+
+    void Reset();
+
+private:
+    struct FSecond
+    {
+        int64 Second = -1;
+        int64 Calls = 0;
+        uint64 TotalCycles = 0;
+        uint64 MaxCycles = 0;
+    };
+
+    struct FEntry
+    {
+        FSecond Seconds[MaxWindowSeconds];
+    };
+
+    TMap<FName, FEntry> Entries;
+};
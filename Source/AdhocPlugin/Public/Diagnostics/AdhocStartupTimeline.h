@@ -0,0 +1,77 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogAdhocStartupTimeline, Log, All)
+
+/** Records what happened (and when) between process start and the server being ready, e.g. startup phases, manager requests and JSON parsing / building.
+ * All times are relative to process start (GStartTime). Recording stops once MarkReady has been called. */
+class ADHOCPLUGIN_API FAdhocStartupTimeline
+{
+public:
+    struct FEntry
+    {
+        FString Name;
+        /** e.g. "phase", "http", "json". */
+        FName Category;
+        double StartSeconds = 0;
+        double DurationSeconds = 0;
+        FString Detail;
+    };
+
+    /** Times a scope and adds it to the timeline (if still recording) when the scope ends. */
+    class ADHOCPLUGIN_API FScope
+    {
+    public:
+        FScope(FAdhocStartupTimeline& InTimeline, FString InName, FName InCategory);
+        ~FScope();
+
+    private:
+        FAdhocStartupTimeline& Timeline;
+        FString Name;
+        FName Category;
+        double StartTime;
+    };
+
+    FORCEINLINE bool IsRecording() const { return ReadySeconds < 0; }
+    FORCEINLINE double GetReadySeconds() const { return ReadySeconds; }
+    FORCEINLINE const TArray<FEntry>& GetEntries() const { return Entries; }
+
+    /** Start and end times are platform times (FPlatformTime::Seconds). */
+    void Add(const FString& Name, FName Category, double StartTime, double EndTime, const FString& Detail = FString());
+
+    /** Phases which start and end in different places (e.g. waiting for a connection). */
+    void BeginPhase(const FString& Name);
+    void EndPhase(const FString& Name, const FString& Detail = FString());
+
+    void MarkReady();
+
+    void LogReport() const;
+    FString ToJson() const;
+    bool SaveJson(const FString& FilePath) const;
+
+private:
+    TArray<FEntry> Entries;
+    TMap<FString, double> OpenPhaseStartTimes;
+    double ReadySeconds = -1;
+};
@@ -35,4 +35,14 @@ struct FAdhocEmission
     FRotator Rotation;
 
     FDateTime Timestamp;
+
+    /** Region of the emitting server, or -1 if not known (in which case it is looked up from the server ID). Area indexes are only meaningful within a region. */
+    int32 RegionID = -1;
+    /** Area (in the emitting server's region) the emission occurred in, or -1 if not known. Lets receiving servers cheaply discard irrelevant emissions. */
+    int32 AreaIndex = -1;
+
+    /** Number of emissions this represents (more than one if nearby emissions were aggregated) so effects can be scaled rather than repeated. */
+    int32 Count = 1;
+    /** Radius (cm) the aggregated emissions were spread over. */
+    float Radius = 0;
 };
@@ -0,0 +1,64 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Emission/AdhocEmissionBuffer.h"
+
+/** Merges emissions of the same category which fall in the same space-time cell into a single emission with a count and radius,
+ * and caps the number of emissions in the buffer, so the size of an emissions event is bounded however intense a fight gets. */
+class ADHOCPLUGIN_API FAdhocEmissionAggregator
+{
+public:
+    /** Size (cm) of the cubic cells emissions are merged within. */
+    float CellSize = 1000;
+    /** Duration (seconds) of the time slices emissions are merged within. */
+    float CellDuration = 0.25f;
+    /** Emissions which cannot be merged once the buffer has this many are dropped. */
+    int32 MaxEmissions = 256;
+
+    FORCEINLINE int64 GetNumMerged() const { return NumMerged; }
+    FORCEINLINE int64 GetNumDropped() const { return NumDropped; }
+
+    /** Add to the buffer, merging with an existing emission in the same cell if there is one. Returns false if the emission was dropped. */
+    bool Add(FAdhocEmissionBuffer& Buffer, const FAdhocEmissionTypeTable& TypeTable, int64 ServerID, uint16 TypeID, const FVector& Location, const FRotator& Rotation,
+        const FDateTime& Timestamp, int32 AreaIndex, int32 Count = 1, float Radius = 0);
+
+    /** Must be called whenever the buffer is reset. */
+    void Reset();
+
+private:
+    struct FCellKey
+    {
+        FName Category;
+        FIntVector Cell;
+        int32 TimeSlice;
+
+        FORCEINLINE bool operator==(const FCellKey& Other) const { return Category == Other.Category && Cell == Other.Cell && TimeSlice == Other.TimeSlice; }
+        FORCEINLINE friend uint32 GetTypeHash(const FCellKey& Key) { return HashCombine(HashCombine(GetTypeHash(Key.Category), GetTypeHash(Key.Cell)), ::GetTypeHash(Key.TimeSlice)); }
+    };
+
+    /** Buffer index of the emission representing each cell. */
+    TMap<FCellKey, int32> CellIndexes;
+
+    int64 NumMerged = 0;
+    int64 NumDropped = 0;
+};
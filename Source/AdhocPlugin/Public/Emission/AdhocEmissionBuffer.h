@@ -0,0 +1,106 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Emission/AdhocEmission.h"
+
+/** Interns emission category / type pairs as small integer IDs so emissions can be stored and compared without strings. */
+class ADHOCPLUGIN_API FAdhocEmissionTypeTable
+{
+public:
+    static constexpr uint16 InvalidTypeID = MAX_uint16;
+
+    /** Returns InvalidTypeID if the table is full. */
+    uint16 FindOrAdd(FName Category, FName Type);
+
+    FORCEINLINE int32 Num() const { return Types.Num(); }
+    FORCEINLINE FName GetCategory(const uint16 TypeID) const { return Types[TypeID].Key; }
+    FORCEINLINE FName GetType(const uint16 TypeID) const { return Types[TypeID].Value; }
+
+private:
+    TArray<TPair<FName, FName>> Types;
+    TMap<TPair<FName, FName>, uint16> TypeIDs;
+};
+
+/** A single emission taken from (or to be added to) a buffer - no strings as the type is an ID in the type table the buffer was filled with. */
+struct FAdhocBufferedEmission
+{
+    int64 ServerID = -1;
+    uint16 TypeID = 0;
+    FVector Location = FVector::ZeroVector;
+    FRotator Rotation = FRotator::ZeroRotator;
+    FDateTime Timestamp;
+    int32 RegionID = -1;
+    int32 AreaIndex = -1;
+    int32 Count = 1;
+    float Radius = 0;
+};
+
+/** Emissions stored as a structure of arrays with interned types and timestamps as millisecond offsets from a base timestamp.
+ * Reset() keeps the allocations so a buffer which is regularly flushed stops allocating once it has grown to its working size. */
+struct ADHOCPLUGIN_API FAdhocEmissionBuffer
+{
+    FDateTime BaseTimestamp;
+    /** Region the area indexes refer to (a buffer only ever holds emissions from one region), or -1 if not known. */
+    int32 RegionID = -1;
+
+    TArray<int64> ServerIDs;
+    TArray<uint16> TypeIDs;
+    TArray<int32> TimestampOffsetsMs;
+    TArray<FVector3f> Locations;
+    TArray<FRotator3f> Rotations;
+    TArray<int32> AreaIndexes;
+    /** Number of emissions each entry represents (more than one if aggregated). */
+    TArray<int32> Counts;
+    /** Radius (cm) the aggregated emissions of each entry were spread over. */
+    TArray<float> Radii;
+
+    FORCEINLINE int32 Num() const { return TypeIDs.Num(); }
+
+    FORCEINLINE FDateTime GetTimestamp(const int32 Index) const { return BaseTimestamp + FTimespan::FromMilliseconds(TimestampOffsetsMs[Index]); }
+
+    void Reset();
+
+    /** The first emission added after a reset becomes the base timestamp. */
+    void Add(int64 ServerID, uint16 TypeID, const FVector& Location, const FRotator& Rotation, const FDateTime& Timestamp, int32 AreaIndex, int32 Count = 1, float Radius = 0);
+
+    /** Add an emission taken from another buffer (the region of this buffer is not changed). */
+    FORCEINLINE void Add(const FAdhocBufferedEmission& Emission)
+    {
+        Add(Emission.ServerID, Emission.TypeID, Emission.Location, Emission.Rotation, Emission.Timestamp, Emission.AreaIndex, Emission.Count, Emission.Radius);
+    }
+
+    FAdhocBufferedEmission Get(int32 Index) const;
+
+    /** Only needed where strings are required (e.g. playing the emission back). */
+    FORCEINLINE void ToEmission(const FAdhocEmissionTypeTable& TypeTable, const int32 Index, FAdhocEmission& OutEmission) const { ToEmission(TypeTable, Get(Index), OutEmission); }
+    static void ToEmission(const FAdhocEmissionTypeTable& TypeTable, const FAdhocBufferedEmission& Emission, FAdhocEmission& OutEmission);
+
+    /** Write an Emissions event. Types are written once per event (indexed by the emissions) and locations / rotations are rounded to whole units. */
+    void WriteEventJson(const FAdhocEmissionTypeTable& TypeTable, FString& OutJsonString) const;
+
+    /** Read an Emissions event written by WriteEventJson (replacing the buffer contents). Types are interned into the given table. */
+    bool ReadEventJson(const TSharedPtr<class FJsonObject>& JsonObject, FAdhocEmissionTypeTable& TypeTable);
+
+    /** Is this an Emissions event in the format written by WriteEventJson (rather than an array of emission objects). */
+    static bool IsBufferEventJson(const TSharedPtr<class FJsonObject>& JsonObject);
+};
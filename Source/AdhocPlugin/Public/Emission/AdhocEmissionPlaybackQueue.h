@@ -0,0 +1,75 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Emission/AdhocEmissionBuffer.h"
+
+/** Time ordered queue (binary min-heap) of emissions waiting to be played back. Enqueue and each played emission are O(log n),
+ * so a single tick can drain any size of batch without a timer / delegate per emission. Emissions are queued without strings. */
+class ADHOCPLUGIN_API FAdhocEmissionPlaybackQueue
+{
+public:
+    /** Emissions beyond this many queued are dropped. */
+    int32 MaxQueuedEmissions = 4096;
+    /** Emissions played more than this (seconds) after they were due are counted as late. */
+    float LateThresholdSeconds = 0.1f;
+    /** Emissions more than this (seconds) overdue are dropped rather than played. */
+    float MaxLatenessSeconds = 1.0f;
+
+    FORCEINLINE bool IsEmpty() const { return Heap.Num() == 0; }
+    FORCEINLINE int32 Num() const { return Heap.Num(); }
+    /** Time the next emission is due (only valid if not empty). */
+    FORCEINLINE double GetNextDueTime() const { return Heap[0].DueTime; }
+
+    FORCEINLINE int64 GetNumPlayed() const { return NumPlayed; }
+    FORCEINLINE int64 GetNumLate() const { return NumLate; }
+    FORCEINLINE int64 GetNumDropped() const { return NumDropped; }
+
+    /** Returns false (and counts a drop) if the queue is full. */
+    bool Enqueue(double DueTime, const FAdhocBufferedEmission& Emission);
+
+    /** Play (in due time order) every emission due at or before Now. */
+    void Drain(double Now, TFunctionRef<void(const FAdhocBufferedEmission&)> PlayEmission);
+
+    void Reset();
+
+private:
+    struct FEntry
+    {
+        double DueTime;
+        /** Keeps emissions due at the same time in the order they were enqueued. */
+        uint64 Sequence;
+        FAdhocBufferedEmission Emission;
+    };
+
+    struct FEntryPredicate
+    {
+        FORCEINLINE bool operator()(const FEntry& A, const FEntry& B) const { return A.DueTime < B.DueTime || (A.DueTime == B.DueTime && A.Sequence < B.Sequence); }
+    };
+
+    TArray<FEntry> Heap;
+    uint64 NextSequence = 0;
+
+    int64 NumPlayed = 0;
+    int64 NumLate = 0;
+    int64 NumDropped = 0;
+};
@@ -23,11 +23,32 @@
 #include "Components/ActorComponent.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Emission/AdhocEmission.h"
+#include "Emission/AdhocEmissionAggregator.h"
+#include "Emission/AdhocEmissionBuffer.h"
+#include "Emission/AdhocEmissionPlaybackQueue.h"
+#include "User/AdhocUserState.h"
+#include "Manager/AdhocManagerClient.h"
+#include "Manager/AdhocEventSequencer.h"
+#include "Manager/AdhocManagerRecording.h"
+#include "Diagnostics/AdhocStartupTimeline.h"
+#include "Structure/AdhocStructureState.h"
 
 #include "AdhocGameModeComponent.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogAdhocGameModeComponent, Log, All)
 
+/** A user the manager has recently verified, so a repeat join with the same token can be admitted without waiting on the manager. */
+struct FAdhocVerifiedUser
+{
+    FAdhocUserState User;
+
+    /** Where the user last was (if known) so they can be spawned back at that location. Set from the join response and updated when they leave or navigate away. */
+    TOptional<FTransform> LastTransform;
+
+    /** Platform time (seconds) after which this entry must not be used. */
+    double ExpiryTime = 0;
+};
+
 UCLASS(Transient)
 class ADHOCPLUGIN_API UAdhocGameModeComponent : public UActorComponent
 {
@@ -57,6 +78,7 @@ private:
 #if WITH_SERVER_CODE && !defined(__EMSCRIPTEN__)
     FString PrivateIP = TEXT("127.0.0.1"); // non-public IP of the server within its hosting service / cluster etc.
     FString ManagerHost = TEXT("127.0.0.1"); // host which is managing this Unreal server (we will talk to and maintain web socket connection to this)
+    int32 ManagerPort = 80; // port of the manager's REST API and web socket (e.g. a different port for a local mock manager)
     TArray<FString> ManagerHosts; // IPs of other managers which we can fall back to
 
     FString BasicAuthUsername = TEXT("server");
@@ -67,19 +89,173 @@ private:
     FString BasicAuthHeaderValue; // a combination of the basic auth username and password
 
     class FHttpModule* Http;
+    /** All manager REST calls (other than the extra structure submission) go through this client (pooling, retries, timeouts and latency tracking). */
+    TSharedPtr<FAdhocManagerClient> ManagerClient;
+    int32 ManagerMaxInFlightRequests = 8;
+    /** Gzip large request bodies (e.g. areas / objectives) - only enable if the manager accepts Content-Encoding: gzip. */
+    bool bManagerCompressRequests = false;
+    int32 ManagerCompressMinBytes = 16 * 1024;
+    /** Send Accept-Encoding: gzip so the manager may compress large responses (e.g. structures). */
+    bool bManagerAcceptCompressedResponses = false;
     class FWebSocketsModule* WebSockets;
     class FStompModule* Stomp;
 
     TSharedPtr<class IStompClient> StompClient;
 
+    /** Port to serve Prometheus format metrics on at /metrics (0 to disable). */
+    int32 MetricsPort = 0;
+    /** Address to serve metrics on (local only unless e.g. 0.0.0.0 is given). */
+    FString MetricsBindAddress = TEXT("127.0.0.1");
+    /** File to periodically write Prometheus format metrics to (empty to disable). */
+    FString MetricsFile;
+    float MetricsFileInterval = 15;
+    FTimerHandle TimerHandle_MetricsFile;
+    FDelegateHandle MetricsCollectHandle;
+
+    /** Append every STOMP event and manager response received to this file (empty to disable) e.g. to reproduce an incident later. */
+    FString ManagerRecordFile;
+    FAdhocManagerRecorder ManagerRecorder;
+    /** Replay a recording made with ManagerRecordFile in place of the manager (no STOMP connection is made and manager requests are dropped). */
+    FString ManagerReplayFile;
+    /** Replay speed relative to the original timing (e.g. 10 for ten times faster). Zero or less replays everything as soon as possible. */
+    float ManagerReplaySpeed = 1;
+    TArray<FAdhocManagerRecord> ReplayRecords;
+    int32 ReplayPosition = 0;
+    double ReplayStartTime = 0;
+    /** Recorded responses which could not be replayed (e.g. user joins, which need the original controller). */
+    int32 NumReplaySkipped = 0;
+
+    /** Add a load generator (see UAdhocLoadGeneratorComponent for its own LoadXXX= options) which spawns bots and triggers events for load testing. */
+    bool bLoadGenerator = false;
+
+    /** Where time went between process start and the server being ready (logged when the server starts, and saved as JSON if StartupTimelineFile= is given). */
+    FAdhocStartupTimeline StartupTimeline;
+    FString StartupTimelineFile;
+
+    /** Subscribe to world / region / server / area scoped event topics instead of the single world-wide /topic/events (the manager must publish to them). */
+    bool bScopedEventTopics = false;
+    /** Subscription IDs of the area scoped event topics we are currently subscribed to (by area index). */
+    TMap<int32, FString> AreaEventSubscriptions;
+
+    /** Orders sequenced events from /topic/events and detects any lost ones. */
+    FAdhocEventSequencer EventSequencer;
+    FTimerHandle TimerHandle_EventSequencer;
+    /** Minimum seconds between resyncs of the same stream (gaps within this time are coalesced into one later resync). */
+    float EventResyncMinInterval = 5;
+    TMap<FName, double> EventResyncTimes;
+    TSet<FName> PendingEventResyncs;
+    TMap<FName, int64> EventResyncCounts;
+
     bool bServerStarted; // set to true once stomp is connected and startup information exchange with manager has completed
 
     FTimerHandle TimerHandle_ServerPawns;
+    FTimerHandle TimerHandle_StateResync;
     FTimerHandle TimerHandle_RecentEmissions;
+    FTimerHandle TimerHandle_BotPool;
+
+    /**
+     * When enabled, users with a token we can verify locally are admitted straight away (the manager join then completes in the background).
+     * Off by default as it needs a manager that provides GET servers/{id}/userTokenKey returning {"key":"<base64 HMAC-SHA1 key>"} and issues tokens
+     * of the form <base64 payload>.<base64 HMAC-SHA1 of payload> where the payload is JSON {"userId":..,"factionId":..,"name":"..","exp":<unix seconds>}.
+     */
+    bool bOptimisticAdmission = false;
+    /** Key used to verify the signature of user tokens (retrieved from the manager at startup when optimistic admission is enabled). Empty until retrieved. */
+    TArray<uint8> UserTokenKey;
+
+    /** How long (seconds) a verified user remains in the cache. Zero (the default) disables the cache. */
+    float VerifiedUserCacheTTL = 0;
+    /** Users recently verified by the manager for this server (keyed by user ID and token). */
+    mutable TMap<TPair<int64, FString>, FAdhocVerifiedUser> VerifiedUsers;
+
+    /** Number of bot users to keep reserved (per faction) so bots can join without waiting on the manager. Zero disables the pool.
+     * NOTE: the manager has no reservation endpoint so each reservation is a bot user join - the manager sees pooled bot users as joined to this server. */
+    int32 BotPoolSize = 0;
+    /** Bot users reserved from the manager which are not currently assigned to a bot (keyed by faction index). */
+    TMap<int32, TArray<FAdhocUserState>> BotPool;
+    /** Number of bot user reservations currently awaiting a manager response (keyed by faction index). */
+    TMap<int32, int32> BotPoolPendingReservations;
+    /** Reservations in a row which returned a bot user we already hold. Refills back off (doubling) while this is non-zero. */
+    int32 NumBotPoolDuplicates = 0;
+    /** Platform time before which the pool is not refilled. */
+    double BotPoolRefillTime = 0;
+
+    /** Emissions further than this (cm) from all of this server's active areas are dropped on receipt. Negative disables the filtering. */
+    float EmissionRelevancyMargin = 20000;
+    /** Send emissions in the compact buffer event format (otherwise the legacy format of an array of emission objects). Every server receives either format. */
+    bool bEmissionBufferFormat = false;
+    /** Play back received emissions from a single time ordered queue drained on tick (rather than handing each batch to OnEmissionsEvent). Off by default. */
+    bool bEmissionPlaybackQueue = false;
+    /** Time (ms) per tick which may be spent materializing received structures. Zero or less materializes every structure as soon as it is received. */
+    float StructureMaterializationBudgetMs = 2;
+    /** Structures within this distance (cm) of an active area are live. */
+    float StructureLiveMargin = 5000;
+    /** Structures further than the live margin but within this distance (cm) of an active area are dormant. Anything further is data only. */
+    float StructureDormantMargin = 50000;
+    /** Retrieve structures from the manager a page at a time (active areas first) rather than as one full exchange, starting once the active areas are loaded. */
+    bool bPagedStructureSync = false;
+    int32 StructureSyncPageSize = 500;
+
+    /** Seconds between asking the manager for factions / servers changed since the last versions we saw (0 to disable). */
+    float StateResyncInterval = 0;
+    /** Every this many resyncs (0 to never) retrieve the full factions / servers rather than a delta, as deltas cannot express deletions. */
+    int32 StateFullResyncEvery = 10;
+    int32 NumStateResyncs = 0;
+
+    /** Highest versions seen from the manager (-1 until a full set has been received). */
+    int64 FactionsVersion = -1;
+    int64 ServersVersion = -1;
+    int64 ObjectivesVersion = -1;
 
 #if WITH_ADHOC_PLUGIN_EXTRA
     /** Recent emissions (e.g. explosions) are cached here to be submitted as an event for all others to see. */
     TArray<FAdhocEmission> RecentEmissions;
+    /** Emission categories / types interned so buffered emissions carry no strings. */
+    FAdhocEmissionTypeTable EmissionTypes;
+    /** Recent emissions when sending in the compact buffer event format (emissions added with strings are moved in here before sending). */
+    FAdhocEmissionBuffer RecentEmissionBuffer;
+    /** Merges recent emissions which are close in space and time (and caps how many are sent per event). */
+    FAdhocEmissionAggregator RecentEmissionAggregator;
+    /** Reused for every received compact emissions event. */
+    FAdhocEmissionBuffer ReceivedEmissionBuffer;
+    /** Received emissions outside our active areas are aggregated (coarsely) into here before being played back. */
+    FAdhocEmissionBuffer DistantEmissionBuffer;
+    FAdhocEmissionAggregator DistantEmissionAggregator;
+    /** Reused for the relevant emissions of every received emissions event (whichever format) - converted to FAdhocEmission only when played. */
+    FAdhocEmissionBuffer RelevantEmissionBuffer;
+    /** Min-heap of (priority, UUID) for pending structures (held by the game state so they can be found before they are materialized) - lower priority values (nearer to players) are materialized first. */
+    TArray<TPair<double, FGuid>> PendingStructureOrder;
+    /** Player locations used for the current pending structure order, and when it was last evaluated. */
+    TArray<FVector> StructureMaterializationPlayerLocations;
+    double StructureMaterializationOrderTime = -1;
+
+    /** Residency of structures materialized by this server (structures not in here were created some other way e.g. the bulk structures response). */
+    TMap<FGuid, EAdhocStructureResidency> StructureResidencies;
+    /** Actors of structures by UUID (added as they are spawned / adopted and removed as they are destroyed). */
+    TMap<FGuid, TWeakObjectPtr<AActor>> StructureActors;
+    /** Set while materializing a structure so the actor spawned for it can be captured. */
+    FGuid MaterializingStructureUUID;
+    FDelegateHandle ActorSpawnedHandle;
+    FDelegateHandle ActorDestroyedHandle;
+
+    /** Areas to retrieve structures for (active areas first), the current position in them and the cursor of the next page within the current area. */
+    TArray<int32> StructureSyncAreaIndexes;
+    int32 StructureSyncAreaPosition = 0;
+    int32 NumActiveStructureSyncAreas = 0;
+    FString StructureSyncCursor;
+    /** Set once every page for the active areas has been received. */
+    bool bStructureSyncActiveAreasReceived = false;
+    bool bStructureSyncPageInFlight = false;
+    /** Received structure JSON waiting to be parsed (parsed incrementally on tick). */
+    TArray<TSharedPtr<class FJsonValue>> PendingStructureJsonValues;
+    int32 PendingStructureJsonIndex = 0;
+
+    struct FPendingStructureOrderPredicate
+    {
+        FORCEINLINE bool operator()(const TPair<double, FGuid>& A, const TPair<double, FGuid>& B) const { return A.Key < B.Key; }
+    };
+
+    /** Received emissions waiting to be played back with their original spacing. */
+    FAdhocEmissionPlaybackQueue EmissionPlaybackQueue;
 #endif
 #endif
 
@@ -89,6 +265,7 @@ private:
     virtual void InitializeComponent() override;
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
     void InitFactionStates() const;
     void InitAreaStates() const;
@@ -121,6 +298,31 @@ private:
     /** Called when a StructureCreated event occurs. */
     void OnStructureCreatedEvent(const struct FAdhocStructureState& Structure) const;
     void UpdateOrCreateStructureActor(const FAdhocStructureState& Structure) const;
+
+    /** Queue a received structure to be materialized (time sliced on tick, nearest to players first). */
+    void EnqueueStructure(const FAdhocStructureState& Structure);
+    double GetStructureMaterializationPriority(const FVector& Location) const;
+    void MaterializePendingStructures();
+
+    EAdhocStructureResidency GetStructureResidency(const FVector& Location) const;
+    /** Add the structure state and (depending on residency) create / update its actor. */
+    void MaterializeStructure(const FAdhocStructureState& Structure);
+    void ApplyStructureResidency(const FGuid& UUID, EAdhocStructureResidency Residency);
+    /** Re-evaluate the residency of every structure (e.g. after the active areas change). Structures which need an actor are queued for materialization. */
+    void UpdateStructureResidencies();
+    /** Index and apply residency to structures created by the bulk structures response (which spawns them without going through the materialization queue). */
+    void AdoptBulkLoadedStructures();
+    AActor* FindStructureActor(const FGuid& UUID);
+
+    void StartStructureSync();
+    void RetrieveStructurePage();
+    /** Retrieve the next structure page (if any) unless one is in flight or the received structures have not yet mostly been parsed. */
+    void RetrieveNextStructurePage();
+    void OnStructurePageResponse(const FAdhocManagerResponse& Response);
+    /** Parse received structures (queueing them for materialization) until the deadline (platform seconds). */
+    void ParsePendingStructures(double Deadline);
+    void OnActorSpawned(AActor* Actor);
+    void OnActorDestroyed(AActor* Actor);
 #endif
 
 public:
@@ -140,6 +342,8 @@ public:
 private:
     bool InEditor() const;
     void ShutdownIfNotInEditor() const;
+    /** Failures during startup are fatal but later ones (e.g. periodic resyncs) are just retried next time. */
+    void ShutdownIfNotStarted() const;
     void KickPlayerIfNotInEditor(APlayerController* PlayerController, const FString& KickReason) const;
 
     void OnStompConnected(const FString& ProtocolVersion, const FString& SessionId, const FString& ServerString);
@@ -147,19 +351,63 @@ private:
     void OnStompConnectionError(const FString& Error) const;
     void OnStompError(const FString& Error) const;
     void OnStompRequestCompleted(bool bSuccess, const FString& Error) const;
+    /** Send to the manager over Stomp (counting messages / bytes per destination). */
+    void SendStompMessage(const TCHAR* Destination, const FString& Body) const;
     void OnStompSubscriptionEvent(const class IStompMessage& Message);
-
-    void RetrieveFactions();
-    void OnFactionsResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful) const;
-
-    void RetrieveServers();
-    void OnServersResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful) const;
+    /** Parse and apply an event body (received over STOMP or replayed from a recording). */
+    void HandleStompEvent(const FString& Destination, const FString& Body, int32 NumBytes);
+    FString SubscribeEventTopic(const FString& Destination);
+    /** Subscribe to the area topics for our active (and nearby) areas and unsubscribe from any others. */
+    void UpdateAreaEventSubscriptions();
+    FString GetAreaEventTopic(int32 AreaIndex) const;
+    void ApplyStompEvent(const TSharedPtr<class FJsonObject>& JsonObject);
+    /** Stream an event type is sequenced in (or none if it is not sequenced). */
+    static FName GetEventStream(const FString& EventType);
+    void OnEventStreamGap(FName SequenceStream);
+    /** Resync only the state affected by a stream (e.g. servers) rather than reloading everything. */
+    void ResyncEventStream(FName Stream);
+    /** Start expecting events after the given version of the state affected by a stream (e.g. once a servers response has been applied). */
+    void SeedEventStream(FName Stream, int64 Version);
+    void OnTimer_EventSequencer();
+
+    void RetrieveUserTokenKey();
+    void OnUserTokenKeyResponse(const FAdhocManagerResponse& Response);
+    /** Verify a signed user token (base64 payload + "." + base64 HMAC-SHA1 signature) without contacting the manager. */
+    bool VerifyUserTokenLocally(const FString& Token, int64 UserID, FAdhocUserState& OutUser) const;
+
+    /** Retrieve factions changed since FactionsVersion (or all of them if bFull or there is no full set yet). */
+    void RetrieveFactions(bool bFull = false);
+    /** bDelta is true if only the factions changed since FactionsVersion were requested. */
+    void OnFactionsResponse(const FAdhocManagerResponse& Response, bool bDelta);
+
+    /** bEventResync is true when catching up on a gap in the servers event stream (a failure is retried rather than being fatal before we have started). */
+    void RetrieveServers(bool bFull = false, bool bEventResync = false);
+    void OnServersResponse(const FAdhocManagerResponse& Response, bool bDelta, bool bEventResync);
+    void OnServersFailure(bool bEventResync);
+
+    void OnTimer_StateResync();
+
+    void OnManagerRequestCompleted(FName Endpoint, const FString& Request, const FAdhocManagerResponse& Response);
+
+    FORCEINLINE bool IsReplaying() const { return ReplayPosition < ReplayRecords.Num(); }
+    void StartReplay();
+    /** Feed recorded messages which are now due back into the handlers which originally received them. */
+    void ReplayDueRecords();
+    void ReplayResponse(const FAdhocManagerRecord& Record);
+
+    /** Refresh gauges just before metrics are exported. */
+    void OnCollectMetrics(FAdhocMetrics& Metrics) const;
+    void OnTimer_MetricsFile() const;
 
     void SubmitAreas();
-    void OnAreasResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+    void OnAreasResponse(const FAdhocManagerResponse& Response);
 
     void SubmitObjectives();
-    void OnObjectivesResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+    void OnObjectivesResponse(const FAdhocManagerResponse& Response);
+
+    /** Retrieve objectives changed since ObjectivesVersion (to catch up on any missed ObjectiveTaken events). */
+    void RetrieveObjectives();
+    void OnRetrieveObjectivesResponse(const FAdhocManagerResponse& Response);
 
 #if WITH_ADHOC_PLUGIN_EXTRA
     void SubmitStructures();
@@ -173,19 +421,34 @@ private:
     void OnServerUpdatedEvent(int32 EventServerID, int32 EventRegionID, const bool bEventEnabled, const bool bEventActive, const FString& EventPrivateIP, const FString& EventPublicIP,
         int32 EventPublicWebSocketPort, const TArray<int64>& EventAreaIDs, const TArray<int32>& EventAreaIndexes) const;
 
-    void SetActiveAreas(int32 RegionID, const TArray<int32>& AreaIndexes) const;
+    void SetActiveAreas(int32 RegionID, const TArray<int32>& AreaIndexes);
 
     /** Called when a WorldUpdated event occurs. */
     void OnWorldUpdatedEvent(int64 WorldWorldID, int64 WorldVersion, const TArray<FString>& WorldManagerHosts);
 
-    void SubmitUserJoin(class UAdhocControllerComponent* AdhocController);
+    /** Submit a user join to the manager. If the user has already been admitted (e.g. using a pooled bot user) the join is only used to reconcile with the manager. */
+    void SubmitUserJoin(class UAdhocControllerComponent* AdhocController, bool bAlreadyAdmitted = false);
     /** When details of the user are received - update the controller to set faction etc. */
-    void OnUserJoinResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, UAdhocControllerComponent* AdhocController, bool bKickOnFailure);
+    void OnUserJoinResponse(const FAdhocManagerResponse& Response, UAdhocControllerComponent* AdhocController, bool bKickOnFailure, bool bAlreadyAdmitted);
+    /** Push the user details onto the controller, player state and any currently possessed pawn. */
+    void ApplyUserJoin(UAdhocControllerComponent* AdhocController, int64 UserID, const FString& UserName, int32 FactionIndex) const;
     void OnUserJoinSuccess(const UAdhocControllerComponent* AdhocController) const;
     void OnUserJoinFailure(const UAdhocControllerComponent* AdhocController) const;
 
+    void CacheVerifiedUser(int64 UserID, const FString& Token, const FAdhocUserState& User, const TOptional<FTransform>& LastTransform) const;
+    const FAdhocVerifiedUser* FindVerifiedUser(int64 UserID, const FString& Token) const;
+    /** Update where a recently verified user last was (when they leave or navigate away) so a repeat join puts them back there. */
+    void UpdateVerifiedUserTransform(const class UAdhocPlayerControllerComponent* AdhocPlayerController, const FTransform& LastTransform) const;
+
+    /** Reserve bot users from the manager until each faction has the desired number of bot users in the pool. */
+    void RefillBotPool();
+    void SubmitBotReservation(int32 FactionIndex);
+    void OnBotReservationResponse(const FAdhocManagerResponse& Response, int32 FactionIndex);
+    /** Take a bot user from the pool (preferring the given faction). Returns false if the pool has nothing suitable. */
+    bool TakeBotUserFromPool(int32 FactionIndex, FAdhocUserState& OutBotUser, int32& OutFactionIndex);
+
     void SubmitNavigate(class UAdhocPlayerControllerComponent* AdhocPlayerController, int32 AreaID) const;
-    void OnNavigateResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, UAdhocPlayerControllerComponent* AdhocPlayerController) const;
+    void OnNavigateResponse(const FAdhocManagerResponse& Response, UAdhocPlayerControllerComponent* AdhocPlayerController) const;
 
     /** Regularly send a server pawns event (includes pawn names, locations etc.). */
     void OnTimer_ServerPawns() const;
@@ -194,13 +457,33 @@ private:
 
 public:
     void AddEmission(const FAdhocEmission& Emission);
+    /** Add an emission without any per emission string allocation (prefer this for frequent emissions such as explosions). */
+    void AddEmission(FName Category, FName Type, const FVector& Location, const FRotator& Rotation);
+
+    /** Set the region / area index of an emission occurring on this server (done for all recent emissions before they are sent if not done when added). */
+    void TagEmissionArea(FAdhocEmission& Emission) const;
 
 private:
+    /** Send recent emissions in whichever format is configured. */
+    void OnTimer_SendRecentEmissions();
     /** Send emissions (e.g. explosions) event if any recent emissions. */
     void OnTimer_RecentEmissions();
+    /** Send a compact emissions event if any emissions have been added to the recent emission buffer. */
+    void SendRecentEmissionBuffer();
 
     static void ExtractEmissionFromJsonObject(const TSharedPtr<class FJsonObject>& JsonObject, FAdhocEmission& OutEmission);
 
+    /** Region of a received emission (looked up from the emitting server if the emission did not say), or -1 if not known. */
+    int32 GetEmissionRegionID(int32 RegionID, int64 ServerID) const;
+    /** Is a received emission in this server's region and in (or near) any of this server's active areas. */
+    bool IsEmissionRelevant(const FVector& Location, int32 RegionID, int32 AreaIndex) const;
+    /** Is a received (relevant) emission outside all of this server's active areas, so only needs a lower detail representation. */
+    bool IsEmissionDistant(const FVector& Location, int32 RegionID, int32 AreaIndex) const;
+    /** Move the aggregated distant emissions into the relevant emission buffer. */
+    void AppendDistantEmissions();
+
+    /** Play back received (relevant) emissions keeping their original spacing relative to the base timestamp. */
+    void ScheduleEmissions(const FDateTime& BaseTimestamp, const FAdhocEmissionBuffer& Emissions);
     void OnEmissionsEvent(const FDateTime& BaseTimestamp, const TArray<FAdhocEmission>& Emissions) const;
     void OnStaggeredEmission(const FAdhocEmission Emission) const;
 #endif
@@ -25,6 +25,7 @@
 #include "Faction/AdhocFactionState.h"
 #include "Objective/AdhocObjectiveState.h"
 #include "Server/AdhocServerState.h"
+#include "Structure/AdhocStructureSpatialHash.h"
 #include "Structure/AdhocStructureState.h"
 
 #include "AdhocGameStateComponent.generated.h"
@@ -62,6 +63,15 @@ class ADHOCPLUGIN_API UAdhocGameStateComponent : public UActorComponent
     UPROPERTY(BlueprintReadOnly, meta = (AllowPrivateAccess = true))
     TMap<FGuid, FAdhocStructureState> Structures;
 
+    /** Structures received but not yet materialized (so not yet in Structures). */
+    TMap<FGuid, FAdhocStructureState> PendingStructures;
+
+    /** Spatial index over Structures and PendingStructures. Updated on every add / remove (IndexStructure must be called for changes made via GetStructures). */
+    FAdhocStructureSpatialHash StructureSpatialHash;
+
+    /** Bounds of the active areas, rebuilt whenever the areas or active areas are set (so this is only maintained on the server). */
+    TArray<FBox> ActiveAreaBounds;
+
 public:
     FORCEINLINE int32 GetServerID() const { return ServerID; }
     FORCEINLINE int32 GetRegionID() const { return RegionID; }
@@ -69,22 +79,29 @@ public:
 
     FORCEINLINE void SetServerID(const int64 NewServerID) { ServerID = NewServerID; }
     FORCEINLINE void SetRegionID(const int64 NewRegionID) { RegionID = NewRegionID; }
-    FORCEINLINE void SetActiveAreaIndexes(const TArray<int32>& NewActiveAreaIndexes) { ActiveAreaIndexes = NewActiveAreaIndexes; }
+    void SetActiveAreaIndexes(const TArray<int32>& NewActiveAreaIndexes);
 
     FORCEINLINE int32 GetNumFactions() const { return Factions.Num(); }
     FORCEINLINE FAdhocFactionState& GetFaction(const int32 FactionIndex) { return Factions[FactionIndex]; }
 
     FORCEINLINE TArray<FAdhocAreaState>::TConstIterator GetAreasConstIterator() const { return Areas.CreateConstIterator(); }
+    FORCEINLINE const TArray<FAdhocAreaState>& GetAreas() const { return Areas; }
+    FORCEINLINE const TArray<FAdhocObjectiveState>& GetObjectives() const { return Objectives; }
 
 #if WITH_ADHOC_PLUGIN_EXTRA
     FORCEINLINE TMap<FGuid, FAdhocStructureState>& GetStructures() { return Structures; }
 #endif
+    FORCEINLINE const TMap<FGuid, FAdhocStructureState>& GetPendingStructures() const { return PendingStructures; }
 
 private:
     explicit UAdhocGameStateComponent(const FObjectInitializer& ObjectInitializer);
 
+    void UpdateActiveAreaBounds();
+
 public:
     void SetFactions(const TArray<FAdhocFactionState>& NewFactions);
+    /** Add (or replace) the faction at its index. */
+    void AddFaction(const FAdhocFactionState& NewFaction);
     void SetAreas(const TArray<FAdhocAreaState>& NewAreas);
     void SetObjectives(const TArray<FAdhocObjectiveState>& NewObjectives);
     void SetServers(const TArray<FAdhocServerState>& NewServers);
@@ -102,6 +119,28 @@ public:
     FAdhocServerState* FindServerByAreaID(const int64 AreaID);
     FAdhocServerState* FindOrInsertServerByID(int64 InServerID);
 
+    /** Index of the area (in this region) containing the location, or -1 if none. */
+    int32 FindAreaIndexByLocation(const FVector& Location) const;
+
+    /** Update the spatial index for a structure which has been added to / changed in / removed from Structures (or PendingStructures). */
+    void IndexStructure(const FGuid& UUID);
+
+    /** Add or replace a structure (and index it). */
+    void AddStructure(const FAdhocStructureState& Structure);
+    /** Add or replace a received structure which is waiting to be materialized (and index it). */
+    void AddPendingStructure(const FAdhocStructureState& Structure);
+    /** Remove a pending structure e.g. to materialize it. It stays indexed (at its pending location) until IndexStructure is next called for it. */
+    bool RemovePendingStructure(const FGuid& UUID, FAdhocStructureState& OutStructure);
+
+    /** Find all structures (including pending structures) whose location is within the box. */
+    void FindStructuresInBox(const FBox& Box, TArray<const FAdhocStructureState*>& OutStructures) const;
+
+    /** Is the location inside (or within Margin of) any active area. Nothing is near until the active areas are known (callers re-evaluate once they are set). */
+    bool IsLocationNearActiveAreas(const FVector& Location, float Margin) const;
+
+    /** Indexes of the active areas plus any other areas (in this region) within Margin of them. A negative margin includes every area in the region. */
+    void FindAreaIndexesNearActiveAreas(float Margin, TArray<int32>& OutAreaIndexes) const;
+
     /** Get a color which represents the given faction, or gray if not a valid faction. */
     UFUNCTION(BlueprintCallable, BlueprintPure)
     FColor GetFactionColorSafe(int32 FactionIndex) const;
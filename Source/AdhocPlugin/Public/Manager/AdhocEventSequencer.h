@@ -0,0 +1,92 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/** Puts events from the manager back into sequence order, independently per stream (e.g. "servers", "objectives").
+ * Events that arrive ahead of a missing one are held in a small reorder buffer. If the missing event has not arrived by the time the buffer is full
+ * or the oldest held event has waited too long, the stream skips past the gap and reports it so the affected state can be resynced. */
+class ADHOCPLUGIN_API FAdhocEventSequencer
+{
+public:
+    struct FStreamStats
+    {
+        int64 NumReceived = 0;
+        /** Events that arrived ahead of a missing one and had to be held back. */
+        int64 NumReordered = 0;
+        /** Events with a sequence number already applied or skipped. */
+        int64 NumDuplicates = 0;
+        int64 NumGaps = 0;
+        /** Total sequence numbers skipped over (i.e. events believed lost). */
+        int64 NumMissed = 0;
+        int32 ReorderDepth = 0;
+        int32 MaxReorderDepth = 0;
+    };
+
+    /** Held events beyond this many in a stream cause the stream to skip the gap. */
+    int32 MaxReorderDepth = 32;
+    /** Held events older than this (seconds) cause the stream to skip the gap. */
+    float MaxReorderWaitSeconds = 1.0f;
+
+    /** Apply is called (in sequence order) for the event and any held events it releases. OnGap is called (before applying) if a gap was skipped. */
+    void Receive(FName Stream, int64 Sequence, const TSharedPtr<FJsonObject>& Event, double Now,
+        TFunctionRef<void(const TSharedPtr<FJsonObject>&)> Apply, TFunctionRef<void(FName)> OnGap);
+
+    /** Set the next sequence expected in a stream from a snapshot of the state it affects (e.g. the highest version in a servers response).
+     * Only moves the stream forward - held events the snapshot already covers are dropped and any held events that follow on are applied. */
+    void Seed(FName Stream, int64 NextSequence, TFunctionRef<void(const TSharedPtr<FJsonObject>&)> Apply);
+
+    /** Skip gaps in any stream whose held events have waited too long. Should be called periodically. */
+    void Flush(double Now, TFunctionRef<void(const TSharedPtr<FJsonObject>&)> Apply, TFunctionRef<void(FName)> OnGap);
+
+    FORCEINLINE bool HasHeldEvents() const { return NumHeldEvents > 0; }
+
+    void GetStats(TMap<FName, FStreamStats>& OutStats) const;
+
+    /** Forget a stream (dropping any events held in it) e.g. once its topic is unsubscribed, so it starts afresh if subscribed again. */
+    void Remove(FName Stream);
+
+    void Reset();
+
+private:
+    struct FHeldEvent
+    {
+        TSharedPtr<FJsonObject> Event;
+        double ReceivedTime;
+    };
+
+    struct FStream
+    {
+        /** -1 until the stream is seeded or (if never seeded) the first event is seen. */
+        int64 NextSequence = -1;
+        TSortedMap<int64, FHeldEvent> Held;
+        FStreamStats Stats;
+    };
+
+    TMap<FName, FStream> Streams;
+    int32 NumHeldEvents = 0;
+
+    void ApplyHeld(FStream& Stream, TFunctionRef<void(const TSharedPtr<FJsonObject>&)> Apply);
+    void SkipGap(FName StreamName, FStream& Stream, TFunctionRef<void(const TSharedPtr<FJsonObject>&)> Apply, TFunctionRef<void(FName)> OnGap);
+};
@@ -0,0 +1,160 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Diagnostics/AdhocMetrics.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogAdhocManagerClient, Log, All)
+
+/** Outcome of a request to the manager (after any retries). */
+struct FAdhocManagerResponse
+{
+    /** Was a response received from the manager at all (i.e. false if connection failed / timed out). */
+    bool bReceived = false;
+
+    /** HTTP response code (0 if no response was received). */
+    int32 ResponseCode = 0;
+
+    FString Content;
+
+    /** Number of attempts made (1 if no retries were needed). */
+    int32 Attempts = 0;
+
+    /** Seconds from the request being submitted until it completed (including any queueing and retries). */
+    double Latency = 0;
+
+    FORCEINLINE bool IsOk() const { return bReceived && ResponseCode == 200; }
+};
+
+DECLARE_DELEGATE_OneParam(FAdhocManagerResponseDelegate, const FAdhocManagerResponse&);
+/** Called for every completed request (before its own delegate) e.g. for diagnostics. Params are the endpoint, "VERB URL" and the response. */
+DECLARE_DELEGATE_ThreeParams(FAdhocManagerRequestCompletedDelegate, FName, const FString&, const FAdhocManagerResponse&);
+
+/** How requests to a particular manager endpoint should behave. */
+struct FAdhocManagerEndpointSettings
+{
+    float TimeoutSeconds = 10;
+
+    /** Retries are only made when there was no response or the manager responded with a server error / too many requests. */
+    int32 MaxRetries = 2;
+
+    /** GETs are always retried (up to MaxRetries) but POSTs only when the endpoint is marked idempotent, as a POST which timed out may have been applied. */
+    bool bIdempotent = false;
+
+    /** Delay before the first retry. Each later retry doubles this, and each delay is randomly jittered to avoid retries from many servers lining up. */
+    float RetryDelaySeconds = 0.5f;
+};
+
+/** Makes REST calls to the manager e.g. /adhoc_api/servers/{id}/... with per-endpoint timeouts, retries (with jitter), a limit on requests in flight,
+ * and latency tracking per endpoint. Requests beyond the in flight limit are queued and sent (in order) as earlier requests complete. */
+class ADHOCPLUGIN_API FAdhocManagerClient : public TSharedFromThis<FAdhocManagerClient>
+{
+public:
+    FAdhocManagerClient(const FString& InManagerHost, int32 InManagerPort, const FString& InAuthorizationHeaderValue);
+    ~FAdhocManagerClient();
+
+    FORCEINLINE void SetMaxInFlightRequests(const int32 NewMaxInFlightRequests) { MaxInFlightRequests = FMath::Max(1, NewMaxInFlightRequests); }
+    FORCEINLINE void SetEndpointSettings(const FName Endpoint, const FAdhocManagerEndpointSettings& Settings) { EndpointSettings.Add(Endpoint, Settings); }
+
+    /** Gzip request bodies of at least MinBytes (UTF-8) and send them with Content-Encoding: gzip. The manager must be configured to accept this. */
+    FORCEINLINE void SetRequestCompression(const bool bEnabled, const int32 MinBytes)
+    {
+        bCompressRequests = bEnabled;
+        MinCompressRequestBytes = FMath::Max(0, MinBytes);
+    }
+    /** Send Accept-Encoding: gzip so the manager may compress large responses (gzipped responses are decoded before the delegate is called). */
+    FORCEINLINE void SetAcceptCompressedResponses(const bool bEnabled) { bAcceptCompressedResponses = bEnabled; }
+    FORCEINLINE void SetOnRequestCompleted(const FAdhocManagerRequestCompletedDelegate& Delegate) { OnRequestCompleted = Delegate; }
+    /** Drop requests without sending them (e.g. when a recording is being replayed in place of the manager). Their delegates will not be called. */
+    FORCEINLINE void SetOffline(const bool bInOffline) { bOffline = bInOffline; }
+
+    FORCEINLINE int32 GetNumInFlightRequests() const { return NumInFlightRequests; }
+    FORCEINLINE int32 GetNumQueuedRequests() const { return NumQueuedRequests; }
+    FORCEINLINE const TMap<FName, FAdhocLatencyHistogram>& GetLatencyHistograms() const { return LatencyHistograms; }
+
+    /** GET a path relative to the manager API e.g. "servers/1/factions". The endpoint name selects the settings and latency histogram. */
+    void Get(FName Endpoint, const FString& Path, const FAdhocManagerResponseDelegate& OnComplete);
+    /** POST JSON content to a path relative to the manager API. */
+    void Post(FName Endpoint, const FString& Path, const FString& JsonContent, const FAdhocManagerResponseDelegate& OnComplete);
+
+    /** Drop any queued requests, pending retries and in flight requests (their delegates will not be called). */
+    void CancelAll();
+
+    void LogLatencySummary() const;
+
+    static bool GzipCompress(const TArray<uint8>& Uncompressed, TArray<uint8>& OutCompressed);
+    /** Uncompressed size is taken from the gzip trailer so this only supports single member gzip data (which is what HTTP servers send). */
+    static bool GzipUncompress(const TArray<uint8>& Compressed, TArray<uint8>& OutUncompressed);
+
+private:
+    struct FPendingRequest
+    {
+        FName Endpoint;
+        FString Verb;
+        FString URL;
+        FString Content;
+        /** Gzipped content (if compression applied) - kept so retries do not compress again. */
+        TArray<uint8> CompressedContent;
+        FAdhocManagerResponseDelegate OnComplete;
+        int32 Attempts = 0;
+        double SubmitTime = 0;
+        FHttpRequestPtr HttpRequest;
+        FTSTicker::FDelegateHandle RetryTickerHandle;
+    };
+
+    FString ManagerHost;
+    int32 ManagerPort;
+    FString AuthorizationHeaderValue;
+
+    FAdhocManagerEndpointSettings DefaultEndpointSettings;
+    TMap<FName, FAdhocManagerEndpointSettings> EndpointSettings;
+
+    bool bCompressRequests = false;
+    int32 MinCompressRequestBytes = 16 * 1024;
+    bool bAcceptCompressedResponses = false;
+    bool bOffline = false;
+
+    int32 MaxInFlightRequests = 8;
+    int32 NumInFlightRequests = 0;
+
+    TQueue<TSharedPtr<FPendingRequest>> QueuedRequests;
+    int32 NumQueuedRequests = 0;
+    /** Requests either in flight or waiting to retry. */
+    TArray<TSharedRef<FPendingRequest>> ActiveRequests;
+
+    TMap<FName, FAdhocLatencyHistogram> LatencyHistograms;
+    FAdhocManagerRequestCompletedDelegate OnRequestCompleted;
+
+    const FAdhocManagerEndpointSettings& GetEndpointSettings(FName Endpoint) const;
+
+    void Submit(const TSharedRef<FPendingRequest>& PendingRequest);
+    void Enqueue(const TSharedRef<FPendingRequest>& PendingRequest);
+    void SendQueuedRequests();
+    void Send(const TSharedRef<FPendingRequest>& PendingRequest);
+    void OnHttpRequestComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bWasSuccessful, TSharedRef<FPendingRequest> PendingRequest);
+    bool OnRetryTicker(float DeltaTime, TSharedRef<FPendingRequest> PendingRequest);
+    FString GetResponseContent(const FHttpResponsePtr& HttpResponse) const;
+    void Complete(const TSharedRef<FPendingRequest>& PendingRequest, const FHttpResponsePtr& HttpResponse);
+};
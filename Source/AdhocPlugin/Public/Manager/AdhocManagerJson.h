@@ -0,0 +1,57 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Area/AdhocAreaState.h"
+#include "Faction/AdhocFactionState.h"
+#include "Objective/AdhocObjectiveState.h"
+#include "Server/AdhocServerState.h"
+
+/** What is sent to the manager about each pawn in a ServerPawns message. */
+struct FAdhocServerPawn
+{
+    FGuid UUID;
+    FString Name;
+    FString Description;
+    FVector Location = FVector::ZeroVector;
+    FRotator Rotation = FRotator::ZeroRotator;
+    int64 UserID = -1;
+    bool bHuman = false;
+    int64 FactionID = -1;
+};
+
+/** Builds and parses the JSON exchanged with the manager. Kept free of actors / worlds so the benchmarks measure exactly what the game mode runs. */
+class ADHOCPLUGIN_API FAdhocManagerJson
+{
+public:
+    /** Body for POST servers/{id}/areas. */
+    static void WriteAreas(const TArray<FAdhocAreaState>& Areas, FString& OutJson);
+    /** Body for POST servers/{id}/objectives (uses Index, Name, Location, InitialFactionIndex, LinkedObjectiveIndexes and AreaIndex of each objective). */
+    static void WriteObjectives(int64 RegionID, const TArray<FAdhocObjectiveState>& Objectives, FString& OutJson);
+    /** Body for /app/ServerPawns. */
+    static void WriteServerPawns(int64 ServerID, const TArray<FAdhocServerPawn>& Pawns, FString& OutJson);
+
+    static bool ParseFactions(FStringView Json, TArray<FAdhocFactionState>& OutFactions);
+    static bool ParseServers(FStringView Json, TArray<FAdhocServerState>& OutServers);
+    static bool ParseAreas(FStringView Json, TArray<FAdhocAreaState>& OutAreas);
+    static bool ParseObjectives(FStringView Json, TArray<FAdhocObjectiveState>& OutObjectives);
+};
@@ -0,0 +1,90 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAdhocManagerResponse;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogAdhocManagerRecording, Log, All)
+
+enum class EAdhocManagerRecordKind : uint8
+{
+    /** A STOMP event (Name is the destination it was received on). */
+    StompEvent = 0,
+    /** A REST response (Name is the endpoint, Request is "VERB URL"). */
+    Response = 1,
+};
+
+/** A message received from the manager. */
+struct FAdhocManagerRecord
+{
+    EAdhocManagerRecordKind Kind = EAdhocManagerRecordKind::StompEvent;
+    /** When it was received (UTC). */
+    FDateTime Timestamp;
+    FString Name;
+    FString Request;
+    bool bReceived = false;
+    int32 ResponseCode = 0;
+    int32 Attempts = 0;
+    double Latency = 0;
+    FString Body;
+};
+
+/** Appends messages received from the manager (STOMP events and REST responses) to a compact binary file so the exact traffic can be replayed later
+ * without a manager. Records are length prefixed so a file cut short by a crash can still be read up to its last complete record. Game thread only.
+ * Recordings hold everything the manager sent (user names, IP addresses etc.) so treat them as sensitive. The user token key response is never recorded
+ * and user tokens in user join / navigate responses are redacted. */
+class ADHOCPLUGIN_API FAdhocManagerRecorder
+{
+public:
+    ~FAdhocManagerRecorder();
+
+    /** Open (creating if needed) the file to append to. An existing file which is not a recording of this version is refused, and one cut short
+     * by a crash is first truncated back to its last complete record (otherwise everything appended after it could not be loaded). */
+    bool Open(const FString& InFilePath);
+    void Close();
+
+    FORCEINLINE bool IsOpen() const { return Writer.IsValid(); }
+    FORCEINLINE int64 GetNumRecords() const { return NumRecords; }
+
+    void RecordStompEvent(const FString& Destination, const FString& Body);
+    void RecordResponse(FName Endpoint, const FString& Request, const FAdhocManagerResponse& Response);
+    void Record(const FAdhocManagerRecord& Record);
+
+    /** Read every complete record in a file (in the order they were recorded). */
+    static bool Load(const FString& FilePath, TArray<FAdhocManagerRecord>& OutRecords);
+
+private:
+    static constexpr uint32 Magic = 0x52444841; // "ADHR"
+    static constexpr uint32 Version = 1;
+
+    /** Read the complete records in a recording's bytes, returning false if it is not a recording of this version. OutValidSize is where the last complete record ends. */
+    static bool Parse(const FString& FilePath, const TArray<uint8>& FileBytes, TArray<FAdhocManagerRecord>& OutRecords, int64& OutValidSize);
+
+    TUniquePtr<FArchive> Writer;
+    FString FilePath;
+    /** Reused for serializing each record before it is written with its length. */
+    TArray<uint8> RecordBytes;
+    int64 NumRecords = 0;
+    /** Platform time of the last flush (the file is flushed at most once a second so little is lost on a crash). */
+    double LastFlushTime = 0;
+};
@@ -0,0 +1,51 @@
+﻿// Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Uniform grid over structure locations (keyed by structure UUID) for "what is in / near this box" queries. */
+class ADHOCPLUGIN_API FAdhocStructureSpatialHash
+{
+public:
+    explicit FAdhocStructureSpatialHash(float InCellSize = 5000);
+
+    FORCEINLINE int32 Num() const { return CellsByUUID.Num(); }
+
+    /** Add the structure or move it if its location has changed. */
+    void Update(const FGuid& UUID, const FVector& Location);
+    void Remove(const FGuid& UUID);
+    void Reset();
+
+    /** Add the UUIDs of all structures in cells overlapping the box (callers should check exact locations if they need to). */
+    void FindInBox(const FBox& Box, TArray<FGuid>& OutUUIDs) const;
+
+private:
+    float CellSize;
+
+    TMap<FIntVector, TArray<FGuid>> Cells;
+    TMap<FGuid, FIntVector> CellsByUUID;
+
+    FORCEINLINE FIntVector GetCell(const FVector& Location) const
+    {
+        return FIntVector(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize), FMath::FloorToInt32(Location.Z / CellSize));
+    }
+};
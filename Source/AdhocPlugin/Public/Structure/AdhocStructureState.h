@@ -24,6 +24,17 @@
 
 #include "AdhocStructureState.generated.h"
 
+/** How much of a structure exists on this server (depends on how close it is to this server's active areas). */
+enum class EAdhocStructureResidency : uint8
+{
+    /** Only the state is kept (no actor). */
+    DataOnly,
+    /** An actor exists but is not ticking and is net dormant. */
+    Dormant,
+    /** A fully active actor. */
+    Live
+};
+
 USTRUCT(BlueprintType)
 struct FAdhocStructureState
 {
@@ -0,0 +1,606 @@
+#!/usr/bin/env python3
+# Copyright (c) 2022-2026 SpeculativeCoder (https://github.com/SpeculativeCoder)
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+"""Minimal stand in for the Adhoc manager so dedicated servers can be started, joined and load tested on a single box.
+
+Serves the /adhoc_api/servers/{id}/... REST endpoints used by UAdhocGameModeComponent and the STOMP over web socket
+endpoint /adhoc_ws/stomp/server on one port. Only the Python standard library is used.
+
+Run the server with e.g. ManagerHost=127.0.0.1 ManagerPort=8088 after starting: python3 adhoc_mock_manager.py --port 8088
+"""
+
+import argparse
+import base64
+import gzip
+import hashlib
+import hmac
+import json
+import logging
+import os
+import random
+import re
+import socket
+import struct
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+log = logging.getLogger("adhoc_mock_manager")
+
+WEB_SOCKET_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+
+# event types which the game mode sequences per stream (see UAdhocGameModeComponent::GetEventStream)
+EVENT_STREAMS = {
+    "ObjectiveTaken": "objectives",
+    "ServerUpdated": "servers",
+    "WorldUpdated": "world",
+    "StructureCreated": "structures",
+}
+
+FACTION_NAMES = ["Team Alpha", "Team Beta", "Team Gamma", "Team Delta"]
+FACTION_COLORS = ["#0088FF", "#FF2200", "#FFFF00", "#00FF00"]
+
+
+class Faults:
+    """Latency and failure injection for REST endpoints and STOMP events."""
+
+    def __init__(self, args):
+        self.latency_ms = args.latency_ms
+        self.jitter_ms = args.latency_jitter_ms
+        self.failure_rate = args.failure_rate
+        self.endpoint_latency_ms = dict(parse_assignments(args.endpoint_latency, float))
+        self.endpoint_failure_rate = dict(parse_assignments(args.endpoint_failure, float))
+        self.event_drop_rate = args.event_drop_rate
+        self.event_delay_ms = args.event_delay_ms
+
+    def delay(self, endpoint):
+        latency_ms = self.endpoint_latency_ms.get(endpoint, self.latency_ms)
+        if self.jitter_ms > 0:
+            latency_ms += random.uniform(0, self.jitter_ms)
+        if latency_ms > 0:
+            time.sleep(latency_ms / 1000)
+
+    def should_fail(self, endpoint):
+        return random.random() < self.endpoint_failure_rate.get(endpoint, self.failure_rate)
+
+    def should_drop_event(self):
+        return random.random() < self.event_drop_rate
+
+
+def parse_assignments(values, convert):
+    for value in values or []:
+        name, _, number = value.partition("=")
+        yield name, convert(number)
+
+
+class State:
+    """World state shared by all servers connected to this manager. Every change bumps the version of its kind (e.g. servers) so sinceVersion queries work.
+    Sequenced events on /topic/events are numbered with these versions so a server can tell which events its last response already covered."""
+
+    def __init__(self, args):
+        self.lock = threading.RLock()
+        self.versions = {}
+        self.region_id = args.region_id
+        self.public_ip = args.public_ip
+        self.server_port = args.server_port
+        self.factions = []
+        self.servers = {}
+        self.areas = {}
+        self.objectives = {}
+        self.users = {}
+        self.next_area_id = 1
+        self.next_objective_id = 1
+        self.next_user_id = 1
+        self.user_token_key = os.urandom(32)
+        for index in range(args.factions):
+            self.factions.append({
+                "id": index + 1,
+                "version": self.bump("factions"),
+                "index": index,
+                "name": FACTION_NAMES[index] if index < len(FACTION_NAMES) else "Team %d" % (index + 1),
+                "color": FACTION_COLORS[index % len(FACTION_COLORS)],
+                "score": 0,
+            })
+
+    def bump(self, kind):
+        self.versions[kind] = self.versions.get(kind, 0) + 1
+        return self.versions[kind]
+
+    def server(self, server_id):
+        server = self.servers.get(server_id)
+        if server is None:
+            server = self.servers[server_id] = {
+                "id": server_id,
+                "version": self.bump("servers"),
+                "regionId": self.region_id,
+                "enabled": True,
+                "active": False,
+                "privateIP": "127.0.0.1",
+                "publicIP": self.public_ip,
+                "publicWebSocketPort": self.server_port,
+                "areaIds": [],
+                "areaIndexes": [],
+            }
+        return server
+
+    def faction_by_index(self, index):
+        return self.factions[index] if 0 <= index < len(self.factions) else None
+
+    def faction_by_id(self, faction_id):
+        return next((faction for faction in self.factions if faction["id"] == faction_id), None)
+
+
+def since(entities, query):
+    match = re.search(r"sinceVersion=(-?\d+)", query)
+    if not match:
+        return list(entities)
+    version = int(match.group(1))
+    return [entity for entity in entities if entity["version"] > version]
+
+
+class Manager:
+    def __init__(self, args):
+        self.args = args
+        self.state = State(args)
+        self.faults = Faults(args)
+        self.connections = set()
+        self.connections_lock = threading.Lock()
+        # sequence numbers are per stream and per destination (like the real manager's scoped topics) - except on /topic/events where
+        # they are the version of the change (so changes made without an event e.g. a server's areas being assigned also show as gaps)
+        self.sequences = {}
+        self.sequences_lock = threading.Lock()
+
+    # ---- REST ----
+
+    def handle_rest(self, verb, path, query, body):
+        """Returns (status, json) for /adhoc_api/<path>."""
+        match = re.fullmatch(r"servers/(\d+)/(\w+)", path)
+        if not match:
+            return 404, {"error": "unknown path %s" % path}
+        server_id, endpoint = int(match.group(1)), match.group(2)
+        handler = getattr(self, "%s_%s" % (verb.lower(), endpoint), None)
+        if handler is None:
+            return 404, {"error": "unknown endpoint %s %s" % (verb, endpoint)}
+        self.faults.delay(endpoint)
+        if self.faults.should_fail(endpoint):
+            return 503, {"error": "injected failure"}
+        with self.state.lock:
+            return handler(server_id, query, body)
+
+    def get_factions(self, server_id, query, body):
+        return 200, since(self.state.factions, query)
+
+    def get_servers(self, server_id, query, body):
+        self.state.server(server_id)
+        return 200, since(self.state.servers.values(), query)
+
+    def get_objectives(self, server_id, query, body):
+        return 200, since(self.state.objectives.values(), query)
+
+    def get_userTokenKey(self, server_id, query, body):
+        return 200, {"key": base64.b64encode(self.state.user_token_key).decode()}
+
+    def get_structures(self, server_id, query, body):
+        return 200, {"structures": []}
+
+    def post_areas(self, server_id, query, body):
+        state = self.state
+        server = state.server(server_id)
+        for area in body:
+            key = (area["regionId"], area["index"])
+            existing = state.areas.get(key)
+            if existing is None:
+                existing = state.areas[key] = {"id": state.next_area_id}
+                state.next_area_id += 1
+            existing.update(area)
+            # first server to claim an area keeps it (other servers can take it over via the control endpoint)
+            existing.setdefault("serverId", server_id)
+            existing["version"] = state.bump("areas")
+        server["areaIds"] = [area["id"] for area in state.areas.values() if area["serverId"] == server_id]
+        server["areaIndexes"] = [area["index"] for area in state.areas.values() if area["serverId"] == server_id]
+        server["version"] = state.bump("servers")
+        return 200, list(state.areas.values())
+
+    def post_objectives(self, server_id, query, body):
+        state = self.state
+        areas_by_index = {area["index"]: area for area in state.areas.values()}
+        for objective in body:
+            key = (objective["regionId"], objective["index"])
+            existing = state.objectives.get(key)
+            if existing is None:
+                existing = state.objectives[key] = {"id": state.next_objective_id}
+                state.next_objective_id += 1
+                faction = state.faction_by_index(objective.get("initialFactionIndex", -1))
+                if faction:
+                    existing["initialFactionId"] = existing["factionId"] = faction["id"]
+                    existing["factionIndex"] = faction["index"]
+            existing.update(objective)
+            # JSON null is not a number to the game mode so unknown IDs are left out rather than null
+            area = areas_by_index.get(objective.get("areaIndex"))
+            if area:
+                existing["areaId"] = area["id"]
+            existing["version"] = state.bump("objectives")
+        objectives_by_index = {objective["index"]: objective for objective in state.objectives.values()}
+        for objective in state.objectives.values():
+            objective["linkedObjectiveIds"] = [objectives_by_index[index]["id"] for index in objective.get("linkedObjectiveIndexes", [])
+                                               if index in objectives_by_index]
+        return 200, list(state.objectives.values())
+
+    def post_userJoin(self, server_id, query, body):
+        state = self.state
+        user_id = body.get("userId")
+        user = state.users.get(user_id) if user_id is not None else None
+        if user is None:
+            faction_id = body.get("factionId") or random.choice(state.factions)["id"]
+            prefix = "User" if body.get("human") else "Bot"
+            user = {"id": state.next_user_id, "name": "%s%d" % (prefix, state.next_user_id), "factionId": faction_id}
+            state.users[user["id"]] = user
+            state.next_user_id += 1
+        user["serverId"] = server_id
+        return 200, user
+
+    def post_userNavigate(self, server_id, query, body):
+        state = self.state
+        area = next((area for area in state.areas.values() if area["id"] == body.get("destinationAreaId")), None)
+        if area is None:
+            return 404, {"error": "unknown area"}
+        server = state.server(area["serverId"])
+        user = state.users.get(body.get("userId"))
+        if user is None:
+            token = base64.urlsafe_b64encode(os.urandom(16)).decode().rstrip("=")
+        else:
+            # signed with the userTokenKey so servers started with OptimisticAdmission=true can verify it locally
+            payload = json.dumps({"userId": user["id"], "factionId": user["factionId"], "name": user["name"],
+                                  "exp": int(time.time()) + 300}, separators=(",", ":")).encode()
+            signature = hmac.new(state.user_token_key, payload, hashlib.sha1).digest()
+            token = "%s.%s" % (base64.b64encode(payload).decode(), base64.b64encode(signature).decode())
+        return 200, {
+            "ip": server["publicIP"],
+            "port": server["publicWebSocketPort"],
+            "webSocketUrl": "ws://%s:%d" % (server["publicIP"], server["publicWebSocketPort"]),
+            "token": token,
+        }
+
+    # ---- STOMP ----
+
+    def on_stomp_send(self, destination, body):
+        try:
+            message = json.loads(body)
+        except ValueError:
+            log.warning("Invalid STOMP message to %s: %s", destination, body[:200])
+            return
+        state = self.state
+        if destination == "/app/ServerStarted":
+            with state.lock:
+                server = state.server(message["serverId"])
+                server["active"] = True
+                server["privateIP"] = message.get("privateIp", server["privateIP"])
+                server["version"] = state.bump("servers")
+                event = self.server_updated_event(server)
+            log.info("Server %d started", message["serverId"])
+            self.publish(event)
+        elif destination == "/app/ObjectiveTaken":
+            with state.lock:
+                objective = next((o for o in state.objectives.values() if o["id"] == message["objectiveId"]), None)
+                faction = state.faction_by_id(message["factionId"])
+                if objective is None or faction is None:
+                    log.warning("Invalid ObjectiveTaken: %s", body)
+                    return
+                objective["factionId"] = faction["id"]
+                objective["factionIndex"] = faction["index"]
+                objective["version"] = state.bump("objectives")
+                faction["score"] += 1
+                faction["version"] = state.bump("factions")
+            self.publish({"eventType": "ObjectiveTaken", "objectiveId": objective["id"], "factionId": faction["id"], "version": objective["version"]})
+        elif destination == "/app/Emissions":
+            # relay as is so every server (including the sender) plays them back
+            self.publish(message)
+        elif destination in ("/app/ServerPawns", "/app/ServerUserDefeat"):
+            pass
+        else:
+            log.info("Unhandled STOMP destination %s", destination)
+
+    @staticmethod
+    def server_updated_event(server):
+        return {
+            "eventType": "ServerUpdated",
+            "serverId": server["id"],
+            "version": server["version"],
+            "regionId": server["regionId"],
+            "enabled": server["enabled"],
+            "active": server["active"],
+            "privateIp": server["privateIP"],
+            "publicIp": server["publicIP"],
+            "publicWebSocketPort": server["publicWebSocketPort"],
+            "areaIds": server["areaIds"],
+            "areaIndexes": server["areaIndexes"],
+        }
+
+    def publish(self, event, destinations=("/topic/events", "/topic/events/world")):
+        """Send an event to every subscription of the given destinations. Sequenced event types are numbered per stream and destination."""
+        if self.faults.event_delay_ms > 0:
+            time.sleep(self.faults.event_delay_ms / 1000)
+        stream = EVENT_STREAMS.get(event.get("eventType"))
+        with self.connections_lock:
+            connections = list(self.connections)
+        for destination in destinations:
+            if stream and destination == "/topic/events" and "version" in event:
+                event = dict(event, sequence=event["version"])
+            elif stream:
+                with self.sequences_lock:
+                    sequence = self.sequences[(stream, destination)] = self.sequences.get((stream, destination), 0) + 1
+                event = dict(event, sequence=sequence)
+            # a dropped sequenced event leaves a gap which the server should detect and resync
+            if self.faults.should_drop_event():
+                log.info("Dropping %s event for %s", event.get("eventType"), destination)
+                continue
+            body = json.dumps(event, separators=(",", ":"))
+            for connection in connections:
+                connection.send_message(destination, body)
+
+    def control(self, verb, path, body):
+        """Test control endpoints under /mock/ e.g. to inject events or take a server down for failover tests."""
+        if verb == "GET" and path == "state":
+            with self.state.lock:
+                state = self.state
+                return 200, {"versions": state.versions, "factions": state.factions, "servers": list(state.servers.values()),
+                             "areas": list(state.areas.values()), "objectives": list(state.objectives.values()), "users": list(state.users.values())}
+        if verb == "POST" and path == "events" and isinstance(body, dict):
+            destinations = body.pop("destinations", ["/topic/events", "/topic/events/world"])
+            self.publish(body, tuple(destinations))
+            return 200, {}
+        match = re.fullmatch(r"servers/(\d+)/(enable|disable)", path)
+        if verb == "POST" and match:
+            with self.state.lock:
+                server = self.state.server(int(match.group(1)))
+                server["enabled"] = server["active"] = match.group(2) == "enable"
+                server["version"] = self.state.bump("servers")
+                event = self.server_updated_event(server)
+            self.publish(event)
+            return 200, server
+        return 404, {"error": "unknown control %s %s" % (verb, path)}
+
+
+class StompConnection:
+    """One web socket connection speaking (just enough) STOMP 1.2."""
+
+    def __init__(self, manager, handler):
+        self.manager = manager
+        self.handler = handler
+        self.send_lock = threading.Lock()
+        self.subscriptions = {}
+        self.message_id = 0
+
+    def run(self):
+        buffer = b""
+        while True:
+            message = self.read_message()
+            if message is None:
+                return
+            buffer += message
+            # a web socket message may hold several STOMP frames (or heart beats) each terminated by NUL
+            while b"\0" in buffer:
+                frame, buffer = buffer.split(b"\0", 1)
+                frame = frame.lstrip(b"\r\n")
+                if frame:
+                    self.on_frame(frame.decode("utf-8"))
+
+    def on_frame(self, frame):
+        head, _, body = frame.partition("\n\n")
+        lines = head.split("\n")
+        command = lines[0].strip()
+        headers = {}
+        for line in lines[1:]:
+            key, _, value = line.rstrip("\r").partition(":")
+            headers.setdefault(key, value)
+        if command in ("CONNECT", "STOMP"):
+            self.send_frame("CONNECTED", {"version": "1.2", "heart-beat": "0,0", "server": "adhoc-mock-manager"})
+        elif command == "SUBSCRIBE":
+            self.subscriptions[headers.get("destination")] = headers.get("id")
+            log.info("Subscribed to %s", headers.get("destination"))
+        elif command == "UNSUBSCRIBE":
+            self.subscriptions = {destination: id for destination, id in self.subscriptions.items() if id != headers.get("id")}
+        elif command == "SEND":
+            self.manager.on_stomp_send(headers.get("destination"), body)
+        elif command == "DISCONNECT":
+            pass
+        if "receipt" in headers:
+            self.send_frame("RECEIPT", {"receipt-id": headers["receipt"]})
+
+    def send_message(self, destination, body):
+        subscription = self.subscriptions.get(destination)
+        if subscription is None:
+            return
+        self.message_id += 1
+        self.send_frame("MESSAGE", {"destination": destination, "subscription": subscription, "message-id": str(self.message_id),
+                                    "content-type": "application/json"}, body)
+
+    def send_frame(self, command, headers, body=""):
+        encoded_body = body.encode("utf-8")
+        headers = dict(headers, **{"content-length": str(len(encoded_body))}) if body else headers
+        frame = command + "\n" + "".join("%s:%s\n" % item for item in headers.items()) + "\n"
+        self.write_message(frame.encode("utf-8") + encoded_body + b"\0")
+
+    # ---- web socket framing ----
+
+    def read_exact(self, count):
+        data = self.handler.rfile.read(count)
+        if len(data) < count:
+            raise ConnectionError("web socket closed")
+        return data
+
+    def read_message(self):
+        payload = b""
+        while True:
+            try:
+                first, second = self.read_exact(2)
+            except (ConnectionError, OSError):
+                return None
+            fin, opcode = first & 0x80, first & 0x0F
+            length = second & 0x7F
+            if length == 126:
+                length = struct.unpack(">H", self.read_exact(2))[0]
+            elif length == 127:
+                length = struct.unpack(">Q", self.read_exact(8))[0]
+            mask = self.read_exact(4) if second & 0x80 else b"\0\0\0\0"
+            data = bytes(byte ^ mask[i % 4] for i, byte in enumerate(self.read_exact(length)))
+            if opcode == 0x8:
+                self.write_frame(0x8, data[:2])
+                return None
+            if opcode == 0x9:
+                self.write_frame(0xA, data)
+                continue
+            if opcode == 0xA:
+                continue
+            payload += data
+            if fin:
+                return payload
+
+    def write_message(self, data):
+        self.write_frame(0x1, data)
+
+    def write_frame(self, opcode, data):
+        if len(data) < 126:
+            header = struct.pack(">BB", 0x80 | opcode, len(data))
+        elif len(data) < 65536:
+            header = struct.pack(">BBH", 0x80 | opcode, 126, len(data))
+        else:
+            header = struct.pack(">BBQ", 0x80 | opcode, 127, len(data))
+        with self.send_lock:
+            try:
+                self.handler.wfile.write(header + data)
+                self.handler.wfile.flush()
+            except OSError:
+                pass
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    manager = None
+
+    def log_message(self, format, *args):
+        log.debug("%s %s", self.address_string(), format % args)
+
+    def read_body(self):
+        length = int(self.headers.get("Content-Length", 0))
+        data = self.rfile.read(length) if length else b""
+        if self.headers.get("Content-Encoding") == "gzip":
+            data = gzip.decompress(data)
+        return json.loads(data) if data else None
+
+    def respond(self, status, content):
+        data = json.dumps(content, separators=(",", ":")).encode("utf-8")
+        self.send_response(status)
+        self.send_header("Content-Type", "application/json")
+        if len(data) >= self.manager.args.gzip_min_bytes and "gzip" in self.headers.get("Accept-Encoding", ""):
+            data = gzip.compress(data)
+            self.send_header("Content-Encoding", "gzip")
+        self.send_header("Content-Length", str(len(data)))
+        self.end_headers()
+        self.wfile.write(data)
+
+    def dispatch(self, verb):
+        path, _, query = self.path.partition("?")
+        try:
+            body = self.read_body() if verb == "POST" else None
+        except ValueError:
+            self.respond(400, {"error": "invalid JSON"})
+            return
+        if path.startswith("/adhoc_api/"):
+            status, content = self.manager.handle_rest(verb, path[len("/adhoc_api/"):], query, body)
+        elif path.startswith("/mock/"):
+            status, content = self.manager.control(verb, path[len("/mock/"):], body)
+        else:
+            status, content = 404, {"error": "not found"}
+        log.info("%s %s -> %d", verb, self.path, status)
+        self.respond(status, content)
+
+    def do_GET(self):
+        if self.path.startswith("/adhoc_ws/stomp/server") and self.headers.get("Upgrade", "").lower() == "websocket":
+            self.upgrade()
+            return
+        self.dispatch("GET")
+
+    def do_POST(self):
+        self.dispatch("POST")
+
+    def upgrade(self):
+        accept = base64.b64encode(hashlib.sha1((self.headers["Sec-WebSocket-Key"] + WEB_SOCKET_GUID).encode()).digest()).decode()
+        self.send_response(101, "Switching Protocols")
+        self.send_header("Upgrade", "websocket")
+        self.send_header("Connection", "Upgrade")
+        self.send_header("Sec-WebSocket-Accept", accept)
+        protocols = [protocol.strip() for protocol in self.headers.get("Sec-WebSocket-Protocol", "").split(",") if protocol.strip()]
+        if protocols:
+            self.send_header("Sec-WebSocket-Protocol", "v12.stomp" if "v12.stomp" in protocols else protocols[0])
+        self.end_headers()
+        self.wfile.flush()
+        self.connection.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+
+        connection = StompConnection(self.manager, self)
+        with self.manager.connections_lock:
+            self.manager.connections.add(connection)
+        log.info("STOMP connection from %s", self.address_string())
+        try:
+            connection.run()
+        finally:
+            with self.manager.connections_lock:
+                self.manager.connections.discard(connection)
+            log.info("STOMP connection from %s closed", self.address_string())
+            self.close_connection = True
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="127.0.0.1", help="address to listen on (use 0.0.0.0 to accept servers on other machines)")
+    parser.add_argument("--port", type=int, default=8088)
+    parser.add_argument("--region-id", type=int, default=1)
+    parser.add_argument("--factions", type=int, default=2)
+    parser.add_argument("--public-ip", default="127.0.0.1", help="IP given to users navigating to a server")
+    parser.add_argument("--server-port", type=int, default=8889, help="web socket port given to users navigating to a server")
+    parser.add_argument("--latency-ms", type=float, default=0, help="delay before every REST response")
+    parser.add_argument("--latency-jitter-ms", type=float, default=0, help="random extra delay (0 to this) before every REST response")
+    parser.add_argument("--endpoint-latency", action="append", metavar="ENDPOINT=MS", help="latency override e.g. userJoin=250")
+    parser.add_argument("--failure-rate", type=float, default=0, help="fraction of REST requests answered with 503")
+    parser.add_argument("--endpoint-failure", action="append", metavar="ENDPOINT=RATE", help="failure rate override e.g. servers=0.5")
+    parser.add_argument("--event-drop-rate", type=float, default=0, help="fraction of STOMP events to drop (sequenced events leave gaps)")
+    parser.add_argument("--event-delay-ms", type=float, default=0, help="delay before publishing each STOMP event")
+    parser.add_argument("--gzip-min-bytes", type=int, default=16 * 1024, help="gzip responses at least this big when the client accepts it")
+    parser.add_argument("--seed", type=int, help="random seed for repeatable failure injection")
+    parser.add_argument("--verbose", action="store_true")
+    args = parser.parse_args()
+
+    logging.basicConfig(level=logging.DEBUG if args.verbose else logging.INFO, format="%(asctime)s %(levelname)s %(message)s")
+    if args.seed is not None:
+        random.seed(args.seed)
+
+    Handler.manager = Manager(args)
+    server = ThreadingHTTPServer((args.host, args.port), Handler)
+    server.daemon_threads = True
+    log.info("Mock manager listening on %s:%d", args.host, args.port)
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()